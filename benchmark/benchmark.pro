@@ -0,0 +1,33 @@
+TEMPLATE = app
+TARGET = monopoly-bench
+QT += core gui widgets
+CONFIG += console c++11 c++14 c++17
+CONFIG -= app_bundle
+
+# Benchmark renders the populated table offscreen and measures paint costs of nodes, hands, decks, details and units.
+# It builds the same table sources as the application (see monopoly.pri) and runs on the offscreen platform, without display.
+
+DEFINES += QT_DEPRECATED_WARNINGS
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+# Game rules live in the core static library (see core/core.pro), benchmark links against it.
+win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../core/release/ -lmonopolycore
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/../core/debug/ -lmonopolycore
+else:unix: LIBS += -L$$OUT_PWD/../core/ -lmonopolycore
+
+win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/release/libmonopolycore.a
+else:win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/debug/libmonopolycore.a
+else:win32:!win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/release/monopolycore.lib
+else:win32:!win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/debug/monopolycore.lib
+else:unix: PRE_TARGETDEPS += $$OUT_PWD/../core/libmonopolycore.a
+
+DEPENDPATH += $$PWD/../core
+
+include(../monopoly.pri)
+
+SOURCES += \
+    main.cpp \
+    renderbenchmark.cpp
+
+HEADERS += \
+    renderbenchmark.h
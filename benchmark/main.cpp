@@ -0,0 +1,99 @@
+#include <QApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+
+#include "table.h"
+#include "ui/assetpack.h"
+#include "benchmark/renderbenchmark.h"
+
+// Benchmark renders the populated table offscreen and writes the paint time of each class of items and frames per second,
+// so the cost of rendering can be tracked between versions on machines without display.
+// Example: monopoly-bench --frames 500 --hand-tokens 30 --output render.csv
+
+int main (int argc, char* argv[])
+{
+    // Scene is rendered into the image, no window is shown, so the offscreen platform is used unless another one is set.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QApplication app (argc, argv);
+    QApplication::setApplicationName("monopoly-bench");
+
+    RenderBenchmark::Settings defaults;
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Renders the table with the default map, random tokens, full hands and decks offscreen and measures paint costs.");
+    parser.addHelpOption();
+
+    QCommandLineOption framesOption ("frames",      "Count of measured frames.", "count", QString::number(defaults.frames));
+    QCommandLineOption warmupOption ("warmup",      "Count of frames rendered before measuring.", "count", QString::number(defaults.warmup));
+    QCommandLineOption scaleOption  ("scale",       "Scale of the rendered image relative to the scene.", "scale", QString::number(defaults.scale));
+    QCommandLineOption handsOption  ("hand-tokens", "Count of ownership tokens added to the hand of each player.", "count", "20");
+    QCommandLineOption seedOption   ("seed",        "Seed of the random generator, used to fill the board, hands and decks.", "seed", "0");
+    QCommandLineOption outputOption ("output",      "File to write results to, standard output if not set.", "file");
+    QCommandLineOption uncachedOption ("uncached",  "Drop cached pixmaps, layouts and shared caches before each frame.");
+    QCommandLineOption assetsOption ("assets",      "Pack of images, made by monopoly-pack.", "file", AssetPack::DEFAULT_PATH);
+    QCommandLineOption mapOption    ("map",         "Map file saved by the table (*.tm), the default map of data directory if not set.", "file");
+    QCommandLineOption atOption     ("at",          "Catalog of action tokens, the one of data directory if not set.", "file");
+    QCommandLineOption otOption     ("ot",          "Catalog of ownership tokens, the one of data directory if not set.", "file");
+    QCommandLineOption cardsOption  ("cards",       "Catalog of cards, the one of data directory if not set.", "file");
+
+    parser.addOptions({framesOption, warmupOption, scaleOption, handsOption, seedOption, outputOption, uncachedOption, assetsOption,
+                       mapOption, atOption, otOption, cardsOption});
+    parser.process(app);
+
+    // 1. Settings.
+    RenderBenchmark::Settings settings;
+    settings.frames   = parser.value(framesOption).toInt();
+    settings.warmup   = parser.value(warmupOption).toInt();
+    settings.scale    = parser.value(scaleOption).toDouble();
+    settings.uncached = parser.isSet(uncachedOption);
+
+    if (settings.frames < 1 || settings.warmup < 0 || settings.scale <= 0)
+    {
+        qDebug() << "There should be at least one frame of positive scale.";
+        return 1;
+    }
+
+    // 2. The same table the play shows, with the same seed each run, so the scenes of different versions match.
+    AssetPack::instance().open(parser.value(assetsOption));
+
+    Table::Files files;
+    if (parser.isSet(mapOption))
+        files.map = parser.value(mapOption);
+    if (parser.isSet(atOption))
+        files.actionTokens = parser.value(atOption);
+    if (parser.isSet(otOption))
+        files.ownershipTokens = parser.value(otOption);
+    if (parser.isSet(cardsOption))
+        files.cards = parser.value(cardsOption);
+
+    Table table;
+    table.setSeed(parser.value(seedOption).toULongLong());
+    table.setFiles(files);
+    table.populate(parser.value(handsOption).toInt());
+
+    // 3. Render and write the results.
+    RenderBenchmark benchmark (table.scene(), settings);
+    RenderBenchmark::Results results = benchmark.run();
+
+    QFile file;
+    if (parser.isSet(outputOption))
+    {
+        file.setFileName(parser.value(outputOption));
+        if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+            qDebug() << "Could not open the output file " << file.fileName();
+    }
+    else
+        file.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+
+    if (!file.isOpen())
+        return 1;
+
+    QTextStream out (&file);
+    benchmark.report(results, out);
+
+    return 0;
+}
@@ -0,0 +1,169 @@
+#include "renderbenchmark.h"
+
+#include <QGraphicsScene>
+#include <QGraphicsItem>
+#include <QStyleOptionGraphicsItem>
+#include <QElapsedTimer>
+#include <QPainter>
+#include <QImage>
+
+#include "cards/deck.h"
+#include "player/hand.h"
+#include "player/player.h"
+#include "ui/boardlayer.h"
+#include "ui/details.h"
+#include "ui/imagecache.h"
+#include "ui/textcache.h"
+#include "ui/spriteatlas.h"
+
+RenderBenchmark::RenderBenchmark(QGraphicsScene *scene, const Settings &settings)
+    : m_scene    (scene)
+    , m_settings (settings)
+{
+
+}
+
+RenderBenchmark::Results RenderBenchmark::run() const
+{
+    Results results;
+    results.items.fill(0, GROUPS_COUNT);
+    results.nsecs.fill(0, GROUPS_COUNT);
+
+    if (!m_scene || m_settings.frames < 1)
+        return results;
+
+    QRectF source = m_scene->sceneRect();
+    QSize  size = (source.size() * m_settings.scale).toSize();
+    QImage image (size, QImage::Format_ARGB32_Premultiplied);
+
+    // 1. Whole scene, the way the view renders it.
+    auto renderScene = [&]()
+    {
+        if (m_settings.uncached)
+            dropCaches();
+
+        QPainter painter (&image);
+        m_scene->render(&painter, QRectF(QPointF(0, 0), size), source);
+    };
+
+    for (int i = 0; i < m_settings.warmup; ++i)
+        renderScene();
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < m_settings.frames; ++i)
+        renderScene();
+    results.sceneNsecs = timer.nsecsElapsed();
+
+    // 2. Each visible item alone, with the same transform, so its time is added to the group of its class.
+    QList<QGraphicsItem*> items;
+    for (QGraphicsItem* item : m_scene->items(Qt::AscendingOrder))
+    {
+        if (!item->isVisible() || (item->flags() & QGraphicsItem::ItemHasNoContents))
+            continue;
+
+        items.append(item);
+        ++results.items[groupOf(item)];
+    }
+
+    QTransform view = QTransform::fromTranslate(-source.left(), -source.top()) * QTransform::fromScale(m_settings.scale, m_settings.scale);
+    QStyleOptionGraphicsItem option;
+
+    for (int i = 0; i < m_settings.frames; ++i)
+    {
+        if (m_settings.uncached)
+            dropCaches();
+
+        QPainter painter (&image);
+        for (QGraphicsItem* item : qAsConst(items))
+        {
+            painter.save();
+            painter.setTransform(item->sceneTransform() * view);
+            option.exposedRect = item->boundingRect();
+            option.rect = option.exposedRect.toAlignedRect();
+
+            timer.restart();
+            item->paint(&painter, &option, nullptr);
+            results.nsecs[groupOf(item)] += timer.nsecsElapsed();
+
+            painter.restore();
+        }
+    }
+
+    results.frames = m_settings.frames;
+    return results;
+}
+
+void RenderBenchmark::report(const Results &results, QTextStream &out) const
+{
+    double sceneMs = results.sceneNsecs / 1e6;
+
+    // Summary.
+    out << "section,summary\n";
+    out << "frames," << results.frames << "\n";
+    out << "scale," << m_settings.scale << "\n";
+    out << "uncached," << (m_settings.uncached ? 1 : 0) << "\n";
+    out << "total_ms," << sceneMs << "\n";
+    out << "ms_per_frame," << (results.frames > 0 ? sceneMs / results.frames : 0) << "\n";
+    out << "fps," << (sceneMs > 0 ? results.frames * 1000 / sceneMs : 0) << "\n";
+    out << "\n";
+
+    if (results.frames == 0)
+        return;
+
+    // Paint time of each group of items per frame and its share of the time of all the items.
+    qint64 total = 0;
+    for (qint64 nsecs : results.nsecs)
+        total += nsecs;
+
+    out << "section,groups\n";
+    out << "group,items,ms_per_frame,share\n";
+    for (int g = 0; g < GROUPS_COUNT; ++g)
+        out << groupName(Group(g)) << "," << results.items.at(g) << ","
+            << results.nsecs.at(g) / 1e6 / results.frames << ","
+            << (total > 0 ? double(results.nsecs.at(g)) / total : 0) << "\n";
+    out << "\n";
+}
+
+const char *RenderBenchmark::groupName(Group group)
+{
+    switch (group)
+    {
+        case NODE:    return "node";
+        case HAND:    return "hand";
+        case DECK:    return "deck";
+        case DETAILS: return "details";
+        case PLAYER:  return "player";
+        case OTHER:   return "other";
+    }
+
+    return "other";
+}
+
+RenderBenchmark::Group RenderBenchmark::groupOf(QGraphicsItem *item)
+{
+    if (dynamic_cast<BoardLayer*>(item)) return NODE;
+    if (dynamic_cast<Hand*>(item))       return HAND;
+    if (dynamic_cast<Deck*>(item))       return DECK;
+    if (dynamic_cast<Details*>(item))    return DETAILS;
+    if (dynamic_cast<Player*>(item))     return PLAYER;
+
+    return OTHER;
+}
+
+void RenderBenchmark::dropCaches() const
+{
+    for (QGraphicsItem* item : m_scene->items())
+    {
+        if (BoardLayer* board = dynamic_cast<BoardLayer*>(item))
+            board->invalidate();
+        else if (Deck* deck = dynamic_cast<Deck*>(item))
+            deck->invalidate();
+        else if (Hand* hand = dynamic_cast<Hand*>(item))
+            hand->invalidateLayout();
+    }
+
+    ImageCache::instance().clear();
+    TextCache::instance().clear();
+    SpriteAtlas::instance().clear();
+}
@@ -0,0 +1,66 @@
+#ifndef RENDERBENCHMARK_H
+#define RENDERBENCHMARK_H
+
+#include <QVector>
+#include <QTextStream>
+
+class QGraphicsScene;
+class QGraphicsItem;
+
+// RenderBenchmark renders the populated scene of the table into the image many times and measures how long it takes.
+// It runs without display (offscreen platform), so paint costs can be compared between versions on any machine.
+// - frames are rendered twice: the whole scene at once (as the view does it) gives frames per second,
+//   then each item is painted alone, so its time is added to the group of its class;
+// - groups are the classes, that are painted during the play: nodes (board layer paints all of them), hands, decks,
+//   details and units, everything else goes to the "other" group;
+// - warm-up frames are not measured, they fill the caches the way the first frames of the play do;
+// - uncached run drops cached pixmaps, layouts and shared caches before each frame, so the cost of rendering them is measured too.
+
+class RenderBenchmark
+{
+public:
+    enum Group {NODE, HAND, DECK, DETAILS, PLAYER, OTHER};
+    static constexpr int GROUPS_COUNT = 6;
+
+    // Settings of the run:
+    // - frames is the count of measured frames, warmup is the count of frames rendered before them;
+    // - scale is the scale of the image relative to the scene;
+    // - uncached drops all the caches before each frame.
+    struct Settings
+    {
+        int   frames = 300;
+        int   warmup = 10;
+        qreal scale = 1;
+        bool  uncached = false;
+    };
+
+    // Results of the run:
+    // - sceneNsecs is the time of rendering the whole scene for all the frames;
+    // - items and nsecs are the count of items in each group and the time of painting them for all the frames.
+    struct Results
+    {
+        int    frames = 0;
+        qint64 sceneNsecs = 0;
+        QVector<int>    items;
+        QVector<qint64> nsecs;
+    };
+
+    // Scene is owned by the caller and should live as long as the benchmark.
+    RenderBenchmark(QGraphicsScene* scene, const Settings& settings);
+
+    // * run renders all the frames and returns the measured times;
+    // * report writes them as CSV sections: summary and groups.
+    Results run () const;
+    void report (const Results& results, QTextStream& out) const;
+
+    static const char* groupName (Group group);
+
+private:
+    static Group groupOf (QGraphicsItem* item);
+    void dropCaches () const;
+
+    QGraphicsScene* m_scene = nullptr;
+    Settings        m_settings;
+};
+
+#endif // RENDERBENCHMARK_H
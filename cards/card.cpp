@@ -5,13 +5,14 @@
 #include <QDebug>
 
 #include "player/player.h"
+#include "ui/imagecache.h"
 
 Card::Card(const QString& name, const QString& description, const QString& imagePath)
 {
     setName(name);
     setDescription(description);
     setBackground();
-    setForeground("D:/monopoly/cards/" + imagePath.trimmed());
+    setForeground("cards/" + imagePath.trimmed());
     setFrontSide(false);
 }
 
@@ -23,11 +24,11 @@ Card::Card(Description *cd)
         return;
     }
 
-    setCardType(stringToType(cd->type().trimmed()));
+    setCardType(cd->cardType());
     setName(cd->name().trimmed());
     setDescription(cd->description());
     setBackground();
-    setForeground("d:/monopoly/cards/" + cd->imagePath().trimmed());
+    setForeground("cards/" + cd->imagePath());
     setFrontSide(false);
 }
 
@@ -86,7 +87,9 @@ void Card::setDescription(const QString &description)
 
 void Card::setForeground(const QString &imagePath)
 {
-    m_imageForeground = QImage(imagePath);
+    // Decoded images are shared by all cards with the same artwork.
+    m_foregroundPath  = imagePath;
+    m_imageForeground = ImageCache::instance().source(imagePath);
 }
 
 void Card::setFrontSide(bool toFrontSide)
@@ -97,8 +100,8 @@ void Card::setFrontSide(bool toFrontSide)
 void Card::setBackground()
 {
     // default values for frontside and backside of the card
-    m_imageCoverFront = QImage("d:/monopoly/cards/card_front.png");
-    m_imageCoverBack  = QImage("d:/monopoly/cards/card_back.png");
+    m_imageCoverFront = ImageCache::instance().source(COVER_FRONT_PATH);
+    m_imageCoverBack  = ImageCache::instance().source(COVER_BACK_PATH);
 }
 
 bool Card::hasOwner() const
@@ -125,50 +128,13 @@ Card::CardType Card::stringToType(const QString &typeString)
 {
     qDebug() << "converting string " << typeString << " to actual type";
 
-    QStringList SL = {"treasure", "overtime", "masterchef", "fast_and_furious", "birthday", "scientist", "together",
-                      "thief", "diversion", "sabotage", "raid", "bribe", "sneak", "spy"};
-
-    QList<CardType> TL = {CardType::TREASURE, CardType::OVERTIME, CardType::MASTERCHEF, CardType::FAST_AND_FURIOUS, CardType::BIRTHDAY, CardType::SCIENTIST, CardType::TOGETHER,
-                          CardType::THIEF, CardType::DIVERSION, CardType::SABOTAGE, CardType::RAID, CardType::BRIBE, CardType::SNEAK, CardType::SPY};
-
-    int index = -1;
-    for (int i = 0; i < SL.count(); ++i)
-    {
-        if (SL.at(i) == typeString)
-        {
-            index = i;
-            break;
-        }
-    }
-
-    if (index >= 0)
-        return TL.at(index);
-    else
-        return Card::CardType::DEFAULT;
+    // String representations are shared with the rules core.
+    return GameTypes::stringToCardType(typeString);
 }
 
 QString Card::typeToString(const Card::CardType &type)
 {
-    QList<CardType> TL = {CardType::TREASURE, CardType::OVERTIME, CardType::MASTERCHEF, CardType::FAST_AND_FURIOUS, CardType::BIRTHDAY, CardType::SCIENTIST, CardType::TOGETHER,
-                          CardType::THIEF, CardType::DIVERSION, CardType::SABOTAGE, CardType::RAID, CardType::BRIBE, CardType::SNEAK, CardType::SPY};
-
-    QStringList SL = {"treasure", "overtime", "masterchef", "fast_and_furious", "birthday", "scientist", "together",
-                      "thief", "diversion", "sabotage", "raid", "bribe", "sneak", "spy"};
-
-    int index = -1;
-    for (int i = 0; i < TL.count(); ++i)
-    {
-        if (TL.at(i) == type)
-        {
-            index = i;
-            break;
-        }
-    }
-
-    if (index >= 0)
-        return SL.at(index);
-    else
-        return "";
+    return GameTypes::cardTypeToString(type);
 }
 
 const QImage &Card::imageFrontBG() const
@@ -186,6 +152,11 @@ const QImage &Card::imageBack() const
     return m_imageCoverBack;
 }
 
+const QString &Card::foregroundPath() const
+{
+    return m_foregroundPath;
+}
+
 void Card::setOwner(Player *player)
 {
     m_owner = player;
@@ -2,7 +2,8 @@
 #define CARD_H
 
 #include <QGraphicsRectItem>
-#include "helper/description.h"
+#include "core/description.h"
+#include "core/gametypes.h"
 
 class Player;
 
@@ -48,9 +49,7 @@ class Player;
 class Card : public QGraphicsRectItem
 {
 public:
-    enum class CardType {TREASURE, OVERTIME, MASTERCHEF, FAST_AND_FURIOUS, BIRTHDAY, SCIENTIST, TOGETHER,
-                         THIEF, DIVERSION, SABOTAGE, RAID, BRIBE, SNEAK, SPY,
-                         DEFAULT};
+    using CardType = GameTypes::CardType;
 
     Card(const QString& name, const QString& description, const QString& imagePath);
     Card(Description* cd);
@@ -65,6 +64,7 @@ public:
     const QImage& imageFrontBG() const;
     const QImage& imageFrontFG() const;
     const QImage& imageBack() const;
+    const QString& foregroundPath() const;
 
     void setName(const QString& name);
     void setDescription(const QString& description);
@@ -87,6 +87,10 @@ public:
     void turnAround();
     void use();
 
+    // Asset IDs of the images of card covers, the same for all cards.
+    static constexpr const char* COVER_FRONT_PATH = "cards/card_front.png";
+    static constexpr const char* COVER_BACK_PATH  = "cards/card_back.png";
+
 private:
 
     CardType m_cardType;
@@ -101,6 +105,7 @@ private:
 
     QString m_name;
     QString m_description;
+    QString m_foregroundPath;
     QImage  m_imageForeground;
     QImage  m_imageCoverFront;
     QImage  m_imageCoverBack;
@@ -3,6 +3,10 @@
 #include <QPainter>
 #include <QDebug>
 
+#include "ui/imagecache.h"
+#include "ui/paintresources.h"
+#include "ui/textcache.h"
+
 Deck::Deck(DeckType deckType, int maxSize)
 {
     setDeckType(deckType);
@@ -16,6 +20,13 @@ Deck::~Deck()
     delete m_cards;
 }
 
+QRectF Deck::boundingRect() const
+{
+    // Visible edge of the stack lies to the right and below of the deck rect, frame pen lies half outside of it.
+    qreal edge = CARD_SHIFT * (VISIBLE_CARDS - 1);
+    return rect().adjusted(-1, -1, edge + 1, edge + 1);
+}
+
 void Deck::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
     Q_UNUSED (option);
@@ -24,44 +35,70 @@ void Deck::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWid
     if (m_cards->isEmpty())
         return;
 
+    qreal ratio = ImageCache::ratioFor(painter);
+    bool themeChanged = (m_revision != PaintResources::instance().revision());
+    if (m_dirty || themeChanged || m_composite.isNull() || !qFuzzyCompare(m_composite.devicePixelRatioF(), ratio))
+        render(ratio);
+
+    painter->drawPixmap(boundingRect().topLeft(), m_composite);
+}
+
+void Deck::render(qreal devicePixelRatio)
+{
+    QRectF bounds = boundingRect();
+
+    m_composite = QPixmap((bounds.size() * devicePixelRatio).toSize());
+    m_composite.setDevicePixelRatio(devicePixelRatio);
+    m_composite.fill(Qt::transparent);
+
+    QPainter painter (&m_composite);
+    painter.translate(-bounds.topLeft());
+
     // Deck frame
-    painter->setPen(QPen(QBrush(Qt::black), 1.0f));
-    painter->drawRect(rect());
-    painter->setPen(QPen(QBrush(Qt::darkGray), 0.5f));
-    painter->drawRect(rect().adjusted(3, 3, -3, -3));
+    const PaintResources& resources = PaintResources::instance();
+    painter.setPen(resources.pen(PaintResources::Pen::DECK_OUTER));
+    painter.drawRect(rect());
+    painter.setPen(resources.pen(PaintResources::Pen::DECK_INNER));
+    painter.drawRect(rect().adjusted(3, 3, -3, -3));
 
     // Preparations for card drawings
-    painter->setPen(QPen(Qt::lightGray, 1.0f));
-    painter->setRenderHint(QPainter::Antialiasing, true);
-    painter->setFont(QFont("Truetypewriter PolyglOTT", 11));
+    painter.setPen(resources.pen(PaintResources::Pen::DECK_TEXT));
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setFont(resources.font(PaintResources::Font::CARD));
 
-    // Cards themselves
+    // Cards themselves. Only the top ones are visible, the rest of the stack is hidden under them.
+    ImageCache& images = ImageCache::instance();
+    int first = qMax(0, m_cards->count() - VISIBLE_CARDS);
     int shift = 0;
     int margin = 3;
-    for (int i = 0; i < m_cards->count(); ++i)
+    for (int i = first; i < m_cards->count(); ++i)
     {
         Card *card = m_cards->at(i);
 
         QRect borderRect = QRect(rect().x() + shift,     rect().y() + shift,      rect().width(),     rect().height());
         QRect  imageRect = QRect(rect().x() + shift + margin, rect().y() + shift + margin, rect().width() - margin, 0.69f*(rect().height() - 2*margin));
         QRect   nameRect = QRect(rect().x() + shift + margin, rect().y() + shift + 0.7f*(rect().height() - 2*margin), rect().width() - margin, 0.3f*(rect().height() - 2*margin));
-        // QRect  descrRect = QRect(rect().x() + shift + margin, rect().y() + shift + 0.6f*(rect().height() - 2*margin), rect().width() - margin, 0.4f*(rect().height() - 2*margin));
-
-        // qDebug() << "Actual Rect of the card " << i << " is: " << borderRect;
-        // painter->drawRect(borderRect.adjusted(-3,-3,3,3));
 
         if (card->isFrontSide())
         {
-            painter->drawImage(borderRect, card->imageFrontBG().scaled(borderRect.width(), borderRect.height()));
-            painter->drawImage(imageRect , card->imageFrontFG().scaled(imageRect.width(),  imageRect.height()));
-            painter-> drawText(nameRect  , card->name(), QTextOption(Qt::AlignCenter | Qt::AlignTop));
-            // painter-> drawText(descrRect , card->description(), QTextOption(Qt::AlignCenter | Qt::AlignTop));
+            images.draw(&painter, borderRect, Card::COVER_FRONT_PATH);
+            images.draw(&painter, imageRect , card->foregroundPath());
+            TextCache::instance().draw(&painter, nameRect, card->name(), resources.text(PaintResources::Text::CENTER_TOP));
         }
         else
-            painter->drawImage(borderRect, card->imageBack().scaled(borderRect.width(), borderRect.height()));
+            images.draw(&painter, borderRect, Card::COVER_BACK_PATH);
 
-        shift += 2;
+        shift += CARD_SHIFT;
     }
+
+    m_dirty = false;
+    m_revision = resources.revision();
+}
+
+void Deck::invalidate()
+{
+    m_dirty = true;
+    update();
 }
 
 void Deck::setDeckType(const Deck::DeckType &deckType)
@@ -89,7 +126,10 @@ void Deck::add(Card *card)
     }
 
     if (!m_cards->contains(card))
+    {
         m_cards->append(card);
+        invalidate();
+    }
 }
 
 void Deck::remove(Card *card)
@@ -106,8 +146,8 @@ void Deck::remove(Card *card)
         return;
     }
 
-    if (m_cards->contains(card))
-        m_cards->removeOne(card);
+    if (m_cards->removeOne(card))
+        invalidate();
 }
 
 bool Deck::isEmpty()
@@ -146,13 +186,23 @@ Card *Deck::takeTop()
     return card;
 }
 
+void Deck::turnTop()
+{
+    Card* card = peekTop();
+    if (card)
+    {
+        card->turnAround();
+        invalidate();
+    }
+}
+
 void Deck::createDeck(int maxCards)
 {
     m_maxSize = maxCards;
     m_cards = new QVector<Card*>();
 }
 
-void Deck::shuffleDeck()
+void Deck::shuffleDeck(GameRandom &random)
 {
     int iterations = 20;
 
@@ -170,9 +220,9 @@ void Deck::shuffleDeck()
 
     for (int iteration = 0; iteration < iterations; ++iteration)
     {
-        int where = rand() % (m_cards->size() / 2);
-        int from = m_cards->size() / 2 + rand() % (m_cards->size() - m_cards->size() / 2);
-        int to = from + rand() % (m_cards->size() - from);
+        int where = random.index(GameRandom::Stream::CARDS, m_cards->size() / 2);
+        int from = m_cards->size() / 2 + random.index(GameRandom::Stream::CARDS, m_cards->size() - m_cards->size() / 2);
+        int to = from + random.index(GameRandom::Stream::CARDS, m_cards->size() - from);
 
         for (int i = where, j = from; i < to - from, j < to; ++i, ++j)
         {
@@ -183,6 +233,8 @@ void Deck::shuffleDeck()
             m_cards->replace(j, card1);
         }
     }
+
+    invalidate();
 }
 
 void Deck::clear()
@@ -197,6 +249,7 @@ void Deck::clear()
         delete m_cards->at(i);
 
     m_cards->clear();
+    invalidate();
 }
 
 int Deck::maxSize()
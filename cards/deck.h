@@ -3,17 +3,29 @@
 
 #include <QGraphicsRectItem>
 #include <QVector>
+#include <QPixmap>
 
 #include "card.h"
+#include "core/gamerandom.h"
+
+// Deck is the stack of cards on the table.
+// It may hold hundreds of cards, but only the top VISIBLE_CARDS of them can be seen, each shifted by CARD_SHIFT px,
+// so the deck is painted from the cached composite of its frame and the visible edge of the stack.
+// - composite is rendered again only after add, remove, takeTop, turnTop, shuffle or clear (and if device pixel ratio or theme changes),
+//   so the cost of paint doesn't depend on count of cards;
+// - turnTop turns the top card over, cards should not be turned around directly, or the composite won't know about it.
 
 class Deck : public QGraphicsRectItem
 {
 public:
     enum class DeckType {POSITIVE, NEGATIVE};
+    static constexpr int VISIBLE_CARDS = 5;
+    static constexpr int CARD_SHIFT = 2;
 
     Deck(DeckType deckType, int maxSize);
     ~Deck();
 
+    QRectF boundingRect() const override;
     virtual void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = Q_NULLPTR) override;
 
     void setDeckType(const DeckType& deckType);
@@ -29,17 +41,24 @@ public:
 
     Card* peekTop();
     Card* takeTop();    
+    void turnTop();
     void use();
 
 private:
     void createDeck(int count);
-    void shuffleDeck();
+    void shuffleDeck(GameRandom& random);
+    void render (qreal devicePixelRatio);
+    void invalidate ();
 
     DeckType m_deckType;
 
     int m_maxSize;
     QVector<Card*> *m_cards = nullptr;
 
+    QPixmap m_composite;
+    bool    m_dirty = true;
+    int     m_revision = 0; // revision of paint resources used for the composite
+
 };
 
 #endif // DECK_H
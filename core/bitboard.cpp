@@ -0,0 +1,157 @@
+#include "bitboard.h"
+
+#include <QtAlgorithms>
+
+// ************************************************** BITBOARD
+
+bool Bitboard::fits(const QPoint &gridPosition)
+{
+    return gridPosition.x() >= 0 && gridPosition.x() < SIZE && gridPosition.y() >= 0 && gridPosition.y() < SIZE;
+}
+
+quint64 Bitboard::bit(const QPoint &gridPosition)
+{
+    return fits(gridPosition) ? (Q_UINT64_C(1) << square(gridPosition)) : 0;
+}
+
+int Bitboard::square(const QPoint &gridPosition)
+{
+    return gridPosition.y() * SIZE + gridPosition.x();
+}
+
+QPoint Bitboard::position(int square)
+{
+    return QPoint(square % SIZE, square / SIZE);
+}
+
+quint64 Bitboard::shift(quint64 board, GameTypes::Direction direction)
+{
+    // Horizontal shifts would move the cells of the edge columns to the neighbouring rows, so those columns are masked out.
+    using Direction = GameTypes::Direction;
+    switch (direction)
+    {
+        case Direction::LEFT:       return (board >> 1) & NOT_RIGHT_COLUMN;
+        case Direction::RIGHT:      return (board << 1) & NOT_LEFT_COLUMN;
+        case Direction::UP:         return  board >> SIZE;
+        case Direction::DOWN:       return  board << SIZE;
+        case Direction::LEFT_UP:    return (board >> (SIZE + 1)) & NOT_RIGHT_COLUMN;
+        case Direction::RIGHT_UP:   return (board >> (SIZE - 1)) & NOT_LEFT_COLUMN;
+        case Direction::LEFT_DOWN:  return (board << (SIZE - 1)) & NOT_RIGHT_COLUMN;
+        case Direction::RIGHT_DOWN: return (board << (SIZE + 1)) & NOT_LEFT_COLUMN;
+        case Direction::NO_MOVE:    return  board;
+    }
+
+    return board;
+}
+
+quint8 Bitboard::neighbours(quint64 board, const QPoint &gridPosition)
+{
+    using Direction = GameTypes::Direction;
+    static const Direction directions[] = {Direction::LEFT, Direction::RIGHT, Direction::UP, Direction::DOWN,
+                                           Direction::LEFT_UP, Direction::LEFT_DOWN, Direction::RIGHT_UP, Direction::RIGHT_DOWN};
+
+    quint64 cell = bit(gridPosition);
+    quint8  mask = 0;
+    for (int i = 0; i < 8; ++i)
+        if (shift(cell, directions[i]) & board)
+            mask |= (1 << i);
+
+    return mask;
+}
+
+int Bitboard::count(quint64 board)
+{
+    return qPopulationCount(board);
+}
+
+int Bitboard::first(quint64 board)
+{
+    return board ? int(qCountTrailingZeroBits(board)) : -1;
+}
+
+// ************************************************** BOARD BITS
+
+BoardBits::BoardBits()
+{
+    clear();
+}
+
+void BoardBits::clear()
+{
+    m_nodes = 0;
+    m_companies = 0;
+    m_outside = 0;
+
+    for (int i = 0; i < GameTypes::ACTION_TYPES_COUNT; ++i)
+        m_actions[i] = 0;
+}
+
+void BoardBits::addNode(const QPoint &gridPosition)
+{
+    if (Bitboard::fits(gridPosition))
+        m_nodes |= Bitboard::bit(gridPosition);
+    else
+        ++m_outside;
+}
+
+void BoardBits::removeNode(const QPoint &gridPosition)
+{
+    if (Bitboard::fits(gridPosition))
+    {
+        clearToken(gridPosition);
+        m_nodes &= ~Bitboard::bit(gridPosition);
+    }
+    else
+        --m_outside;
+}
+
+void BoardBits::setAction(const QPoint &gridPosition, GameTypes::ActionType actionType)
+{
+    clearToken(gridPosition);
+    m_actions[static_cast<int>(actionType)] |= Bitboard::bit(gridPosition);
+}
+
+void BoardBits::setCompany(const QPoint &gridPosition)
+{
+    clearToken(gridPosition);
+    m_companies |= Bitboard::bit(gridPosition);
+}
+
+void BoardBits::clearToken(const QPoint &gridPosition)
+{
+    quint64 cell = ~Bitboard::bit(gridPosition);
+
+    m_companies &= cell;
+    for (int i = 0; i < GameTypes::ACTION_TYPES_COUNT; ++i)
+        m_actions[i] &= cell;
+}
+
+bool BoardBits::isValid() const
+{
+    return m_outside == 0;
+}
+
+quint64 BoardBits::nodes() const
+{
+    return m_nodes;
+}
+
+quint64 BoardBits::actions(GameTypes::ActionType actionType) const
+{
+    return m_actions[static_cast<int>(actionType)];
+}
+
+quint64 BoardBits::companies() const
+{
+    return m_companies;
+}
+
+quint8 BoardBits::neighbours(const QPoint &gridPosition) const
+{
+    return Bitboard::neighbours(m_nodes, gridPosition);
+}
+
+int BoardBits::first(GameTypes::ActionType actionType) const
+{
+    return Bitboard::first(actions(actionType));
+}
@@ -0,0 +1,72 @@
+#ifndef BITBOARD_H
+#define BITBOARD_H
+
+#include <QtGlobal>
+#include <QPoint>
+
+#include "core/gametypes.h"
+
+// Bitboard is the set of cells of the default 8x8 board packed into one 64-bit number, one bit per cell.
+// Square of the cell is y * 8 + x, so the rows follow each other from the top and cells in a row go from the left.
+// Sets of nodes, tokens, units or companies can then be checked, combined and counted with a few shifts, masks and popcounts.
+// - fits returns true, if grid position lies on 8x8 board (larger custom maps can't be packed);
+// - bit returns the set with the only cell, square and position convert between the cell and its number;
+// - shift moves all the cells of the set one step in specific direction, cells, that leave the board, are dropped;
+// - neighbours returns the mask of taken cells around grid position, bits go in sequence L-R-U-D-LU-LD-RU-RD;
+// - count returns count of cells in the set, first returns the square of the first one (or -1 for empty set).
+
+class Bitboard
+{
+public:
+    static constexpr int SIZE = 8;
+    static constexpr quint64 NOT_LEFT_COLUMN  = Q_UINT64_C(0xfefefefefefefefe);
+    static constexpr quint64 NOT_RIGHT_COLUMN = Q_UINT64_C(0x7f7f7f7f7f7f7f7f);
+
+    static bool    fits      (const QPoint& gridPosition);
+    static quint64 bit       (const QPoint& gridPosition);
+    static int     square    (const QPoint& gridPosition);
+    static QPoint  position  (int square);
+    static quint64 shift     (quint64 board, GameTypes::Direction direction);
+    static quint8  neighbours(quint64 board, const QPoint& gridPosition);
+    static int     count     (quint64 board);
+    static int     first     (quint64 board);
+};
+
+// BoardBits keeps the bitboards of the board contents in sync with the nodes:
+// - nodes is the set of all cells, that have nodes;
+// - actions are the sets of nodes with action tokens, one per action type;
+// - companies is the set of nodes with ownership tokens.
+// If some node lies outside of 8x8 board, bitboards are not valid and owners should use their usual lookups.
+
+class BoardBits
+{
+public:
+    BoardBits();
+
+    // * clear removes all the nodes;
+    // * addNode and removeNode change the set of nodes, removed node loses its token too;
+    // * setAction, setCompany and clearToken mark the token of the node;
+    // * isValid returns true, if all the nodes lie on 8x8 board;
+    // * neighbours and first are the shortcuts for relevant Bitboard methods applied to nodes and action tokens.
+    void clear ();
+    void addNode    (const QPoint& gridPosition);
+    void removeNode (const QPoint& gridPosition);
+    void setAction  (const QPoint& gridPosition, GameTypes::ActionType actionType);
+    void setCompany (const QPoint& gridPosition);
+    void clearToken (const QPoint& gridPosition);
+
+    bool    isValid   () const;
+    quint64 nodes     () const;
+    quint64 actions   (GameTypes::ActionType actionType) const;
+    quint64 companies () const;
+    quint8  neighbours(const QPoint& gridPosition) const;
+    int     first     (GameTypes::ActionType actionType) const;
+
+private:
+    quint64 m_nodes = 0;
+    quint64 m_actions[GameTypes::ACTION_TYPES_COUNT];
+    quint64 m_companies = 0;
+    int     m_outside = 0; // count of nodes, that don't fit the board
+};
+
+#endif // BITBOARD_H
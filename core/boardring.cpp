@@ -0,0 +1,170 @@
+#include "boardring.h"
+
+#include <QDebug>
+
+#include <algorithm>
+
+BoardRing::BoardRing()
+    : m_index (-1)
+{
+}
+
+bool BoardRing::compile(const QVector<QPoint> &gridPositions)
+{
+    m_order.clear();
+    m_index.reset(0, 0);
+    m_error.clear();
+
+    if (gridPositions.count() < 4)
+    {
+        fail(QString("The ring should contain at least 4 nodes, there are %1.").arg(gridPositions.count()));
+        return false;
+    }
+
+    // Index the nodes by their positions, so neighbours can be found without searching.
+    GridIndex<int> nodes (-1);
+    for (int i = 0; i < gridPositions.count(); ++i)
+        nodes.set(gridPositions.at(i), i);
+
+    // Each node of the closed ring has exactly two neighbours: the one it is entered from and the one it is left to.
+    const QPoint shifts[] = {QPoint(-1,0), QPoint(1,0), QPoint(0,-1), QPoint(0,1)};
+    for (int i = 0; i < gridPositions.count(); ++i)
+    {
+        int neighbours = 0;
+        for (const QPoint& shift : shifts)
+            neighbours += nodes.contains(gridPositions.at(i) + shift) ? 1 : 0;
+
+        if (neighbours != 2)
+        {
+            fail(QString("The node at (%1,%2) has %3 neighbours instead of 2.").arg(gridPositions.at(i).x()).arg(gridPositions.at(i).y()).arg(neighbours));
+            return false;
+        }
+    }
+
+    // Walk around the ring from the first node, never stepping back, until the first node is reached again.
+    QVector<QPoint> order;
+    QPoint previous = gridPositions.first();
+    QPoint current  = gridPositions.first();
+    do
+    {
+        order.append(current);
+
+        for (const QPoint& shift : shifts)
+        {
+            QPoint candidate = current + shift;
+            if (candidate != previous && nodes.contains(candidate))
+            {
+                previous = current;
+                current  = candidate;
+                break;
+            }
+        }
+    }
+    while (current != gridPositions.first() && order.count() <= gridPositions.count());
+
+    if (order.count() != gridPositions.count())
+    {
+        fail(QString("The ring passes through %1 of %2 nodes, the rest are not connected to it.").arg(order.count()).arg(gridPositions.count()));
+        return false;
+    }
+
+    // Orientation of the walk is found by the sign of its area (shoelace formula).
+    // Y axis of the grid looks down, so positive area means clockwise walk. Counter clockwise walk is reversed.
+    qint64 area = 0;
+    for (int i = 0; i < order.count(); ++i)
+    {
+        const QPoint& a = order.at(i);
+        const QPoint& b = order.at((i + 1) % order.count());
+        area += qint64(a.x()) * b.y() - qint64(b.x()) * a.y();
+    }
+
+    if (area < 0)
+        std::reverse(order.begin(), order.end());
+
+    m_order = order;
+    for (int i = 0; i < m_order.count(); ++i)
+        m_index.set(m_order.at(i), i);
+
+    return true;
+}
+
+bool BoardRing::isClosed() const
+{
+    return !m_order.isEmpty();
+}
+
+const QString &BoardRing::error() const
+{
+    return m_error;
+}
+
+int BoardRing::count() const
+{
+    return m_order.count();
+}
+
+int BoardRing::indexOf(const QPoint &gridPosition) const
+{
+    return m_index.at(gridPosition);
+}
+
+QPoint BoardRing::at(int index) const
+{
+    Q_ASSERT_X(index >= 0 && index < m_order.count(), "BoardRing::at", "Ring index is out of range.");
+
+    return m_order.at(index);
+}
+
+int BoardRing::next(int index, GameTypes::Constraint constraint) const
+{
+    return advance(index, 1, constraint);
+}
+
+int BoardRing::advance(int index, int steps, GameTypes::Constraint constraint) const
+{
+    if (index < 0 || index >= m_order.count() || constraint == GameTypes::Constraint::UNCONSTRAINED)
+        return -1;
+
+    // Counter clockwise movement walks the same sequence backwards.
+    int count = m_order.count();
+    int shift = (constraint == GameTypes::Constraint::CLOCKWISE) ? steps % count : -(steps % count);
+
+    return (index + shift + count) % count;
+}
+
+int BoardRing::distance(int from, int to, GameTypes::Constraint constraint) const
+{
+    int count = m_order.count();
+    if (from < 0 || from >= count || to < 0 || to >= count || constraint == GameTypes::Constraint::UNCONSTRAINED)
+        return -1;
+
+    return (constraint == GameTypes::Constraint::CLOCKWISE) ? (to - from + count) % count : (from - to + count) % count;
+}
+
+int BoardRing::passes(int from, int steps, GameTypes::Constraint constraint, int target) const
+{
+    int first = distance(from, target, constraint);
+    if (first < 0 || steps <= 0)
+        return 0;
+
+    // Unit standing on the target reaches it again only after the whole circle.
+    if (first == 0)
+        first = m_order.count();
+
+    return (steps >= first) ? 1 + (steps - first) / m_order.count() : 0;
+}
+
+GameTypes::Direction BoardRing::direction(int index, GameTypes::Constraint constraint) const
+{
+    int successor = next(index, constraint);
+    if (successor < 0)
+        return GameTypes::Direction::NO_MOVE;
+
+    return GameTypes::vectorToDirection(m_order.at(successor) - m_order.at(index));
+}
+
+void BoardRing::fail(const QString &error)
+{
+    m_error = error;
+    qDebug() << "The board is not a closed ring." << error;
+}
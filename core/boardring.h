@@ -0,0 +1,58 @@
+#ifndef BOARDRING_H
+#define BOARDRING_H
+
+#include <QVector>
+#include <QString>
+#include <QPoint>
+
+#include "core/gametypes.h"
+#include "core/gridindex.h"
+
+// BoardRing is the compiled form of the board, that units walk around.
+// Instead of looking at neighbours and guessing the direction on corners during every step,
+// the nodes are put once (after map is loaded or edited) into the sequence, in which they follow each other clockwise.
+// Then the successor of any node for any movement constraint is just the next or previous element of this sequence.
+// - ring index is the position of the node in clockwise sequence, grid positions are converted with indexOf and at;
+// - the board is the closed ring, if each node has exactly two neighbours (left, right, up or down) and all nodes are connected.
+//   Otherwise compile returns false, error describes the problem and the ring stays empty.
+
+class BoardRing
+{
+public:
+    BoardRing();
+
+    // * compile builds the ring from the grid positions of all nodes, returns false if they don't form the closed ring;
+    // * isClosed returns true, if the last compilation was successful;
+    // * error returns the description of the problem found by the last compilation;
+    // * count returns the count of nodes in the ring.
+    bool compile  (const QVector<QPoint>& gridPositions);
+    bool isClosed () const;
+    const QString& error () const;
+    int  count () const;
+
+    // Traversal:
+    // * indexOf returns ring index of the node at grid position or -1;
+    // * at returns grid position of the node with ring index;
+    // * next returns ring index of the node, that follows specific one for movement constraint (-1 for UNCONSTRAINED);
+    // * advance returns ring index of the node, that is specific count of steps away from specific one (negative steps go back);
+    // * distance returns count of steps from one node to another;
+    // * passes returns how many times the unit, that makes specific count of steps, passes (or lands on) the target node;
+    // * direction returns the direction of the step from the node to its successor.
+    // Together advance and passes resolve the whole movement at once, without making it step by step.
+    int    indexOf (const QPoint& gridPosition) const;
+    QPoint at      (int index) const;
+    int    next    (int index, GameTypes::Constraint constraint) const;
+    int    advance (int index, int steps, GameTypes::Constraint constraint) const;
+    int    distance(int from, int to, GameTypes::Constraint constraint) const;
+    int    passes  (int from, int steps, GameTypes::Constraint constraint, int target) const;
+    GameTypes::Direction direction (int index, GameTypes::Constraint constraint) const;
+
+private:
+    void fail (const QString& error);
+
+    QVector<QPoint> m_order;  // grid positions of nodes in clockwise sequence
+    GridIndex<int>  m_index;  // ring indexes of nodes by their grid positions
+    QString         m_error;
+};
+
+#endif // BOARDRING_H
@@ -0,0 +1,165 @@
+#include "catalogcache.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QSaveFile>
+#include <QFile>
+#include <QDebug>
+
+using ObjectType = Description::ObjectType;
+
+QString CatalogCache::pathFor(const QString &filename)
+{
+    return filename + ".cache";
+}
+
+QByteArray CatalogCache::hashOf(QIODevice *device)
+{
+    // The device is read by blocks, so large catalogs are not loaded into memory just to be hashed.
+    QCryptographicHash hash (QCryptographicHash::Sha1);
+    if (!hash.addData(device))
+        return QByteArray();
+
+    return hash.result();
+}
+
+bool CatalogCache::read(ObjectType objectType, const QString &path, const QByteArray &hash, QList<Description*> &descriptions)
+{
+    QFile file (path);
+    if (!file.open(QIODevice::ReadOnly))
+        return false;
+
+    QDataStream stream (&file);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    // 1. Header: the file should be of this format and made from the same XML contents.
+    quint32 magic = 0;
+    quint16 version = 0;
+    quint8  type = 0;
+    QByteArray sourceHash;
+    stream >> magic >> version >> type >> sourceHash;
+
+    if (magic != MAGIC || version != FORMAT_VERSION || type != quint8(objectType) || sourceHash != hash)
+        return false;
+
+    // 2. Columns: each of them has one element per description.
+    qint32 count = 0;
+    Columns columns;
+    stream >> count >> columns.indexes >> columns.types >> columns.names >> columns.descriptions >> columns.imagePaths
+           >> columns.buyingCosts >> columns.basicIncomes >> columns.upgradeLevels >> columns.upgradeCosts >> columns.upgradeIncomes;
+
+    if (stream.status() != QDataStream::Ok || count < 0 || !columns.fit(count))
+        return false;
+
+    // Types become enumerations without conversion, so damaged file must not give values out of them.
+    for (int t : qAsConst(columns.types))
+    {
+        if (!typeFits(objectType, t))
+        {
+            qDebug() << "The compiled catalog " << path << " has unknown type " << t << ", it is made again.";
+            return false;
+        }
+    }
+
+    // 3. Descriptions are made from already parsed values.
+    for (int i = 0; i < count; ++i)
+    {
+        int index = columns.indexes.at(i);
+        int t = columns.types.at(i);
+        const QString& name = columns.names.at(i);
+        const QString& description = columns.descriptions.at(i);
+        const QString& imagePath = columns.imagePaths.at(i);
+
+        switch (objectType)
+        {
+            case ObjectType::OWNERSHIP_TOKEN:
+                descriptions.append(new Description(index, name, description, imagePath,
+                                                    columns.buyingCosts.at(i), columns.basicIncomes.at(i), columns.upgradeLevels.at(i),
+                                                    columns.upgradeCosts.at(i), columns.upgradeIncomes.at(i)));
+                break;
+
+            case ObjectType::ACTION_TOKEN:
+                descriptions.append(new Description(index, static_cast<Description::ActionType>(qMax(0, t)), t >= 0, name, description, imagePath));
+                break;
+
+            case ObjectType::CARD:
+                descriptions.append(new Description(index, static_cast<Description::CardType>(t), name, description, imagePath));
+                break;
+
+            case ObjectType::EMPTY:
+                break;
+        }
+    }
+
+    return true;
+}
+
+bool CatalogCache::write(ObjectType objectType, const QString &path, const QByteArray &hash, const QList<Description*> &descriptions)
+{
+    // 1. Columns of fields, unknown type of action token is stored as -1.
+    Columns columns;
+    for (const Description* d : descriptions)
+    {
+        int t = -1;
+        if (objectType == ObjectType::ACTION_TOKEN && d->isKnownType())
+            t = static_cast<int>(d->actionType());
+        else if (objectType == ObjectType::CARD)
+            t = static_cast<int>(d->cardType());
+
+        columns.indexes.append(d->index());
+        columns.types.append(t);
+        columns.names.append(d->name());
+        columns.descriptions.append(d->description());
+        columns.imagePaths.append(d->imagePath());
+        columns.buyingCosts.append(d->buyingCost());
+        columns.basicIncomes.append(d->basicIncome());
+        columns.upgradeLevels.append(d->upgradeLevel());
+        columns.upgradeCosts.append(d->upgradeCost());
+        columns.upgradeIncomes.append(d->upgradeIncome());
+    }
+
+    // 2. Header and columns are written into the temporary file, that replaces the old one only when it is complete.
+    QSaveFile file (path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qDebug() << "Could not write the compiled catalog " << path;
+        return false;
+    }
+
+    QDataStream stream (&file);
+    stream.setVersion(QDataStream::Qt_5_15);
+
+    stream << MAGIC << FORMAT_VERSION << quint8(objectType) << hash;
+    stream << qint32(descriptions.count()) << columns.indexes << columns.types << columns.names << columns.descriptions << columns.imagePaths
+           << columns.buyingCosts << columns.basicIncomes << columns.upgradeLevels << columns.upgradeCosts << columns.upgradeIncomes;
+
+    if (stream.status() != QDataStream::Ok || !file.commit())
+    {
+        qDebug() << "Could not write the compiled catalog " << path;
+        return false;
+    }
+
+    return true;
+}
+
+bool CatalogCache::typeFits(ObjectType objectType, int type)
+{
+    // Unknown type of action token is stored as -1, unknown type of card is CardType::DEFAULT.
+    switch (objectType)
+    {
+        case ObjectType::ACTION_TOKEN:    return type >= -1 && type < GameTypes::ACTION_TYPES_COUNT;
+        case ObjectType::CARD:            return type >= 0  && type <= static_cast<int>(Description::CardType::DEFAULT);
+        case ObjectType::OWNERSHIP_TOKEN: return type == -1;
+        case ObjectType::EMPTY:           break;
+    }
+
+    return false;
+}
+
+bool CatalogCache::Columns::fit(int count) const
+{
+    return indexes.count() == count && types.count() == count
+        && names.count() == count && descriptions.count() == count && imagePaths.count() == count
+        && buyingCosts.count() == count && basicIncomes.count() == count && upgradeLevels.count() == count
+        && upgradeCosts.count() == count && upgradeIncomes.count() == count;
+}
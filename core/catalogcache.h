@@ -0,0 +1,60 @@
+#ifndef CATALOGCACHE_H
+#define CATALOGCACHE_H
+
+#include <QList>
+#include <QString>
+#include <QByteArray>
+#include <QIODevice>
+#include <QVector>
+#include <QStringList>
+
+#include "core/description.h"
+
+// CatalogCache is the compiled form of the catalog of tokens or cards, that is stored next to its XML file.
+// Parsing XML takes the most of the start time (and simulator processes start by thousands),
+// so the descriptions are written into the binary file once and are read from it on the next starts.
+// - compiled file is the header (MAGIC, FORMAT_VERSION, object type, hash of XML contents) and the columns of fields,
+//   one element per description: types (enumeration values), indexes, costs and incomes are stored as parsed integers,
+//   upgrade arrays as arrays of them, so reading the file doesn't parse any text;
+// - the file is valid only for the same contents of XML and the same format, otherwise read fails and caller parses XML again;
+// - write replaces the file atomically, so processes, that start at the same time, never see the half-written one;
+//   if the directory of the catalog is read-only, nothing is written and XML is parsed on each start as before.
+
+class CatalogCache
+{
+public:
+    static constexpr quint32 MAGIC = 0x4d434154; // "MCAT"
+    static constexpr quint16 FORMAT_VERSION = 2;
+
+    // * pathFor returns the path of compiled file for the XML file;
+    // * hashOf returns the hash of XML contents read from the device till its end, compiled file is valid only for the same hash;
+    // * read fills descriptions from compiled file, returns false (and leaves them empty), if the file is absent, stale or broken;
+    // * write stores descriptions into compiled file, returns false, if it could not be written.
+    static QString    pathFor (const QString& filename);
+    static QByteArray hashOf  (QIODevice* device);
+    static bool read  (Description::ObjectType objectType, const QString& path, const QByteArray& hash, QList<Description*>& descriptions);
+    static bool write (Description::ObjectType objectType, const QString& path, const QByteArray& hash, const QList<Description*>& descriptions);
+
+private:
+    // * typeFits returns true, if the stored type is the value of enumeration for the objects (or the mark of unknown type).
+    static bool typeFits (Description::ObjectType objectType, int type);
+
+    // Columns are the fields of all the descriptions, fit returns true, if each column has count elements.
+    struct Columns
+    {
+        QVector<qint32> indexes;
+        QVector<qint32> types;
+        QStringList     names;
+        QStringList     descriptions;
+        QStringList     imagePaths;
+        QVector<qint32> buyingCosts;
+        QVector<qint32> basicIncomes;
+        QVector<qint32> upgradeLevels;
+        QVector<QVector<int>> upgradeCosts;
+        QVector<QVector<int>> upgradeIncomes;
+
+        bool fit (int count) const;
+    };
+};
+
+#endif // CATALOGCACHE_H
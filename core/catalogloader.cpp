@@ -0,0 +1,160 @@
+#include "catalogloader.h"
+
+#include <QDebug>
+#include <QFile>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QXmlStreamReader>
+
+#include "core/catalogcache.h"
+
+QList<Description*> CatalogLoader::load(Description::ObjectType objectType, const QString &filename)
+{
+    QList<Description*> descriptions;
+
+    // 0. Check file existence and format.
+    QFileInfo fi (filename);
+    QFile file (filename);
+    if (!fi.exists() || fi.completeSuffix() != "xml" || !file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Could not read the file " << filename;
+        return descriptions;
+    }
+
+    // 1. Take the compiled catalog, if it has been made from the same contents.
+    QString    compiled = CatalogCache::pathFor(filename);
+    QByteArray hash = CatalogCache::hashOf(&file);
+    if (CatalogCache::read(objectType, compiled, hash, descriptions))
+        return descriptions;
+
+    // 2. Otherwise parse XML and compile it for the next starts.
+    file.seek(0);
+    descriptions = parse(objectType, &file, filename);
+    if (!descriptions.isEmpty())
+        CatalogCache::write(objectType, compiled, hash, descriptions);
+
+    return descriptions;
+}
+
+QList<Description*> CatalogLoader::parse(Description::ObjectType objectType, QIODevice *device, const QString &filename)
+{
+    QList<Description*> descriptions;
+
+    QString tag = tagFor(objectType);
+    if (tag.isEmpty())
+        return descriptions;
+
+    // Catalogs are decoded the way they always were (by the text stream, not by their declaration), then the reader gets them by chunks.
+    // When the chunk is over, the reader stops with premature end error and continues from the same place after the next one is added.
+    QTextStream text (device);
+    QXmlStreamReader reader;
+
+    Fields   fields;
+    QString* field = nullptr;
+    bool     inObject = false;
+
+    while (true)
+    {
+        QXmlStreamReader::TokenType token = reader.readNext();
+
+        if (reader.error() == QXmlStreamReader::PrematureEndOfDocumentError)
+        {
+            if (text.atEnd())
+                break;
+
+            reader.addData(text.read(CHUNK));
+            continue;
+        }
+
+        if (token == QXmlStreamReader::Invalid || token == QXmlStreamReader::EndDocument)
+            break;
+
+        // Object starts a new set of fields, elements inside it choose the field, that gets their text.
+        if (token == QXmlStreamReader::StartElement)
+        {
+            if (!inObject && reader.name() == tag)
+            {
+                inObject = true;
+                fields = Fields();
+
+                QStringRef index = reader.attributes().value("index");
+                if (index.isEmpty())
+                    qDebug() << QString("%1:%2: %3 has no index.").arg(filename).arg(reader.lineNumber()).arg(tag);
+                fields.index = index.toInt();
+            }
+            else if (inObject)
+            {
+                field = fieldFor(fields, reader.name());
+                if (field)
+                    field->clear();
+                else
+                    qDebug() << QString("%1:%2: unknown field %3 of %4 is skipped.").arg(filename).arg(reader.lineNumber()).arg(reader.name().toString()).arg(tag);
+            }
+        }
+        else if (token == QXmlStreamReader::Characters)
+        {
+            if (field)
+                field->append(reader.text());
+        }
+        else if (token == QXmlStreamReader::EndElement)
+        {
+            if (inObject && reader.name() == tag)
+            {
+                inObject = false;
+                descriptions.append(descriptionFor(objectType, fields));
+            }
+
+            field = nullptr;
+        }
+    }
+
+    // Broken catalog gives nothing, as it did, when the whole document could not be parsed.
+    if (reader.hasError())
+    {
+        qDebug() << QString("%1:%2:%3: %4").arg(filename).arg(reader.lineNumber()).arg(reader.columnNumber()).arg(reader.errorString());
+
+        qDeleteAll(descriptions);
+        descriptions.clear();
+    }
+
+    return descriptions;
+}
+
+QString CatalogLoader::tagFor(Description::ObjectType objectType)
+{
+    switch (objectType)
+    {
+        case Description::ObjectType::OWNERSHIP_TOKEN: return "ownership_token";
+        case Description::ObjectType::ACTION_TOKEN:    return "action_token";
+        case Description::ObjectType::CARD:            return "card";
+        case Description::ObjectType::EMPTY:           break;
+    }
+
+    return QString();
+}
+
+QString *CatalogLoader::fieldFor(Fields &fields, const QStringRef &tag)
+{
+    // Tokens name their image "image_filename", cards name it "imagePath".
+    if (tag == QLatin1String("type"))           return &fields.type;
+    if (tag == QLatin1String("name"))           return &fields.name;
+    if (tag == QLatin1String("description"))    return &fields.description;
+    if (tag == QLatin1String("image_filename")) return &fields.imagePath;
+    if (tag == QLatin1String("imagePath"))      return &fields.imagePath;
+    if (tag == QLatin1String("buying_cost"))    return &fields.buyingCost;
+    if (tag == QLatin1String("basic_income"))   return &fields.basicIncome;
+    if (tag == QLatin1String("upgrade_cost"))   return &fields.upgradeCost;
+    if (tag == QLatin1String("upgrade_level"))  return &fields.upgradeLevel;
+    if (tag == QLatin1String("upgrade_income")) return &fields.upgradeIncome;
+
+    return nullptr;
+}
+
+Description *CatalogLoader::descriptionFor(Description::ObjectType objectType, const Fields &fields)
+{
+    if (objectType == Description::ObjectType::OWNERSHIP_TOKEN)
+        return new Description(fields.index, fields.name, fields.description, fields.imagePath,
+                               fields.buyingCost, fields.basicIncome, fields.upgradeCost, fields.upgradeLevel, fields.upgradeIncome);
+
+    return new Description(fields.index, objectType, fields.type, fields.name, fields.description, fields.imagePath);
+}
@@ -0,0 +1,50 @@
+#ifndef CATALOGLOADER_H
+#define CATALOGLOADER_H
+
+#include <QList>
+#include <QString>
+#include <QIODevice>
+
+#include "core/description.h"
+
+// CatalogLoader reads the catalogs of tokens and cards (at.xml, ot.xml, cards.xml) into descriptions.
+// It is shared by the table and headless tools, so both of them see the same tokens and cards.
+// - load returns the descriptions of all the objects of specific type found in the file, caller owns them.
+//   Empty list is returned, if the file could not be parsed or has no such objects.
+//   Descriptions are taken from the compiled catalog (see CatalogCache), if it has been made from the same contents,
+//   otherwise XML is parsed and the compiled catalog is written for the next starts;
+// - parse reads the objects from XML stream: the file is decoded and fed to the reader by CHUNK characters,
+//   so the memory used for parsing doesn't depend on the size of the catalog (only the descriptions themselves do);
+// - fields of the object are found by their tag names, so their order, comments and whitespace between them don't matter.
+//   Unknown fields are skipped, XML errors are reported with the line and column, where they have been found.
+
+class CatalogLoader
+{
+public:
+    static constexpr int CHUNK = 64 * 1024;
+
+    static QList<Description*> load  (Description::ObjectType objectType, const QString& filename);
+    static QList<Description*> parse (Description::ObjectType objectType, QIODevice* device, const QString& filename);
+
+private:
+    // Fields are the texts of one object, gathered while it is read.
+    struct Fields
+    {
+        int     index = 0;
+        QString type;
+        QString name;
+        QString description;
+        QString imagePath;
+        QString buyingCost;
+        QString basicIncome;
+        QString upgradeCost;
+        QString upgradeLevel;
+        QString upgradeIncome;
+    };
+
+    static QString tagFor (Description::ObjectType objectType);
+    static QString* fieldFor (Fields& fields, const QStringRef& tag);
+    static Description* descriptionFor (Description::ObjectType objectType, const Fields& fields);
+};
+
+#endif // CATALOGLOADER_H
@@ -0,0 +1,41 @@
+TEMPLATE = lib
+TARGET = monopolycore
+QT = core
+CONFIG += staticlib c++11 c++14 c++17
+
+# Core is the static library with the data model and the headless rules model (RulesEngine), that the simulator plays by.
+# The table applies the same rules to its scene by its own code, see the note in core/rulesengine.h.
+# It must not depend on widgets or graphics scene, so it can be used by the application as well as by headless tools.
+
+DEFINES += QT_DEPRECATED_WARNINGS
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+# Sources include the headers relative to the repository root, like the application does ("core/gamestate.h").
+INCLUDEPATH += $$PWD/..
+
+SOURCES += \
+    bitboard.cpp \
+    boardring.cpp \
+    catalogcache.cpp \
+    catalogloader.cpp \
+    description.cpp \
+    gamerandom.cpp \
+    gamerules.cpp \
+    gamestate.cpp \
+    gametypes.cpp \
+    rulesengine.cpp \
+    turnscheduler.cpp
+
+HEADERS += \
+    bitboard.h \
+    boardring.h \
+    catalogcache.h \
+    catalogloader.h \
+    description.h \
+    gamerandom.h \
+    gamerules.h \
+    gamestate.h \
+    gametypes.h \
+    gridindex.h \
+    rulesengine.h \
+    turnscheduler.h
@@ -0,0 +1,83 @@
+#include "description.h"
+
+#include <QStringList>
+
+Description::Description(int index, const QString &name, const QString &description, const QString &imagePath, const QString &buyingCost, const QString &basicIncome, const QString &upgradeCost, const QString &upgradeLevel, const QString &upgradeIncome)
+    : Description(index, name, description, imagePath,
+                  buyingCost.toInt(), basicIncome.toInt(), upgradeLevel.toInt(),
+                  arrayStringToIntegerVector(upgradeCost), arrayStringToIntegerVector(upgradeIncome))
+{
+}
+
+Description::Description(int index, const ObjectType& object, const QString &type, const QString &name, const QString &description, const QString &imagePath)
+{
+    Q_ASSERT_X((object == ObjectType::ACTION_TOKEN || object == ObjectType::CARD), "Description::Description", "This constructor is for action tokens and cards.");
+
+    m_objectType = object;
+
+    m_index = index;
+    m_name = name;
+    m_description = description;
+    m_imagePath = imagePath.trimmed();
+
+    if (object == ObjectType::ACTION_TOKEN)
+        m_actionType = GameTypes::stringToActionType(type, &m_knownType);
+    else
+    {
+        m_cardType = GameTypes::stringToCardType(type);
+        m_knownType = (m_cardType != CardType::DEFAULT);
+    }
+}
+
+Description::Description(int index, ActionType actionType, bool knownType, const QString &name, const QString &description, const QString &imagePath)
+{
+    m_objectType = ObjectType::ACTION_TOKEN;
+
+    m_index = index;
+    m_actionType = actionType;
+    m_knownType = knownType;
+    m_name = name;
+    m_description = description;
+    m_imagePath = imagePath.trimmed();
+}
+
+Description::Description(int index, CardType cardType, const QString &name, const QString &description, const QString &imagePath)
+{
+    m_objectType = ObjectType::CARD;
+
+    m_index = index;
+    m_cardType = cardType;
+    m_knownType = (cardType != CardType::DEFAULT);
+    m_name = name;
+    m_description = description;
+    m_imagePath = imagePath.trimmed();
+}
+
+Description::Description(int index, const QString &name, const QString &description, const QString &imagePath, int buyingCost, int basicIncome, int upgradeLevel, const QVector<int> &upgradeCost, const QVector<int> &upgradeIncome)
+{
+    m_objectType = ObjectType::OWNERSHIP_TOKEN;
+
+    m_index = index;
+    m_name = name;
+    m_description = description;
+    m_imagePath = imagePath.trimmed();
+    m_buyingCost = buyingCost;
+    m_basicIncome = basicIncome;
+    m_upgradeLevel = upgradeLevel;
+    m_upgradeCost = upgradeCost;
+    m_upgradeIncome = upgradeIncome;
+}
+
+QVector<int> Description::arrayStringToIntegerVector(const QString &string)
+{
+    // The method is used to convert strings like "%d,%d,%d" into vector of corresponding integers.
+    // NOTE: Return values can be zeroes, if .toInt() method could not parse the string.
+
+    QStringList sl = string.split(',');
+
+    QVector<int> iv;
+    for (int i = 0; i < sl.count(); ++i)
+        iv.append(sl.at(i).toInt());
+
+    return iv;
+}
@@ -0,0 +1,84 @@
+#ifndef DESCRIPTION_H
+#define DESCRIPTION_H
+
+#include <QString>
+#include <QVector>
+
+#include "core/gametypes.h"
+
+// Description is the helper class to store information of tokens and cards, loaded from the XML file.
+// It has constructors to build instances holding everything needed to create any existing token or card.
+// Usually constructor uses just some variables leaving the rest empty.
+// Texts of XML are parsed once, when the description is made: types become enumerations, costs and incomes become integers,
+// so tokens and cards are created from descriptions without any string parsing.
+// - upgrade arrays are implicitly shared, each token made from the description refers to the same data until it changes it;
+// - image path is trimmed, isKnownType is false, if the type of action token is not one of GameTypes::ActionType
+//   (unknown types of cards become CardType::DEFAULT).
+
+class Description
+{
+public:
+    enum class ObjectType  {ACTION_TOKEN, OWNERSHIP_TOKEN, CARD, EMPTY};
+    using ActionType = GameTypes::ActionType;
+    using CardType   = GameTypes::CardType;
+
+    // ACTION_TOKEN or CARD depending of ObjectType, type is the text of XML
+    Description(int index,
+                const ObjectType& object, const QString& type,
+                const QString& name,   const QString& description, const QString& imagePath);
+
+    // OWNERSHIP_TOKEN, costs and incomes are the texts of XML
+    Description(int index,
+                const QString& name,        const QString& description, const QString& imagePath,
+                const QString& buyingCost,  const QString& basicIncome,
+                const QString& upgradeCost, const QString& upgradeLevel, const QString& upgradeIncome);
+
+    // Typed constructors, used by compiled catalogs, that store already parsed values.
+    Description(int index, ActionType actionType, bool knownType,
+                const QString& name, const QString& description, const QString& imagePath);
+    Description(int index, CardType cardType,
+                const QString& name, const QString& description, const QString& imagePath);
+    Description(int index,
+                const QString& name, const QString& description, const QString& imagePath,
+                int buyingCost, int basicIncome, int upgradeLevel,
+                const QVector<int>& upgradeCost, const QVector<int>& upgradeIncome);
+
+    ObjectType objectType() const { return m_objectType; };
+
+    int index() const { return m_index; };
+    ActionType actionType() const { return m_actionType; };
+    CardType   cardType()   const { return m_cardType; };
+    bool       isKnownType() const { return m_knownType; };
+
+    const QString& name() const { return m_name; };
+    const QString& description() const { return m_description; };
+    const QString& imagePath() const { return m_imagePath; };
+
+    int buyingCost() const { return m_buyingCost; };
+    int basicIncome() const { return m_basicIncome; };
+    int upgradeLevel() const { return m_upgradeLevel; };
+    const QVector<int>& upgradeCost() const { return m_upgradeCost; };
+    const QVector<int>& upgradeIncome() const { return m_upgradeIncome; };
+
+private:
+    static QVector<int> arrayStringToIntegerVector(const QString& string);
+
+    ObjectType m_objectType = ObjectType::EMPTY;
+
+    int m_index;
+    ActionType m_actionType = ActionType::START;
+    CardType   m_cardType = CardType::DEFAULT;
+    bool       m_knownType = false;
+
+    QString m_name;
+    QString m_description;
+    QString m_imagePath;
+
+    int m_buyingCost = 0;
+    int m_basicIncome = 0;
+    int m_upgradeLevel = 0;
+    QVector<int> m_upgradeCost;
+    QVector<int> m_upgradeIncome;
+};
+
+#endif // DESCRIPTION_H
@@ -0,0 +1,124 @@
+#include "gamerandom.h"
+
+#include <QRandomGenerator>
+
+GameRandom::GameRandom(quint64 seed)
+{
+    reseed(seed);
+}
+
+quint64 GameRandom::randomSeed()
+{
+    return QRandomGenerator::system()->generate64();
+}
+
+void GameRandom::reseed(quint64 seed)
+{
+    m_seed = seed;
+
+    // The first stream is filled from the seed, each next one is the previous one moved 2^128 numbers forward.
+    quint64 x = seed;
+    for (int i = 0; i < 4; ++i)
+        m_streams[0].s[i] = splitMix(x);
+
+    for (int i = 1; i < STREAMS_COUNT; ++i)
+    {
+        m_streams[i] = m_streams[i - 1];
+        jump(m_streams[i]);
+    }
+}
+
+quint64 GameRandom::seed() const
+{
+    return m_seed;
+}
+
+quint64 GameRandom::next(Stream stream)
+{
+    return next(m_streams[static_cast<int>(stream)]);
+}
+
+int GameRandom::bounded(Stream stream, int low, int high)
+{
+    Q_ASSERT_X(low <= high, "GameRandom::bounded", "low should not be greater than high");
+
+    // Values from the incomplete last range are dropped, so each value of [low; high] has the same chance.
+    quint64 range = quint64(qint64(high) - qint64(low)) + 1;
+    quint64 limit = ~quint64(0) - (~quint64(0) % range);
+
+    quint64 value;
+    do
+        value = next(stream);
+    while (value >= limit);
+
+    return int(qint64(low) + qint64(value % range));
+}
+
+int GameRandom::index(Stream stream, int count)
+{
+    Q_ASSERT_X(count > 0, "GameRandom::index", "There should be at least one element to choose from.");
+
+    return bounded(stream, 0, count - 1);
+}
+
+bool GameRandom::chance(Stream stream, int percent)
+{
+    return bounded(stream, 0, 100) <= percent;
+}
+
+quint64 GameRandom::splitMix(quint64 &x)
+{
+    quint64 z = (x += Q_UINT64_C(0x9e3779b97f4a7c15));
+    z = (z ^ (z >> 30)) * Q_UINT64_C(0xbf58476d1ce4e5b9);
+    z = (z ^ (z >> 27)) * Q_UINT64_C(0x94d049bb133111eb);
+    return z ^ (z >> 31);
+}
+
+quint64 GameRandom::rotl(quint64 x, int k)
+{
+    return (x << k) | (x >> (64 - k));
+}
+
+quint64 GameRandom::next(State &state)
+{
+    quint64* s = state.s;
+    const quint64 result = rotl(s[1] * 5, 7) * 9;
+    const quint64 t = s[1] << 17;
+
+    s[2] ^= s[0];
+    s[3] ^= s[1];
+    s[1] ^= s[2];
+    s[0] ^= s[3];
+
+    s[2] ^= t;
+    s[3] = rotl(s[3], 45);
+
+    return result;
+}
+
+void GameRandom::jump(State &state)
+{
+    static const quint64 JUMP[] = {Q_UINT64_C(0x180ec6d33cfd0aba), Q_UINT64_C(0xd5a61266f0c9392c),
+                                   Q_UINT64_C(0xa9582618e03fc9aa), Q_UINT64_C(0x39abdc4529b1661c)};
+
+    quint64 s0 = 0, s1 = 0, s2 = 0, s3 = 0;
+    for (quint64 word : JUMP)
+    {
+        for (int b = 0; b < 64; ++b)
+        {
+            if (word & (Q_UINT64_C(1) << b))
+            {
+                s0 ^= state.s[0];
+                s1 ^= state.s[1];
+                s2 ^= state.s[2];
+                s3 ^= state.s[3];
+            }
+            next(state);
+        }
+    }
+
+    state.s[0] = s0;
+    state.s[1] = s1;
+    state.s[2] = s2;
+    state.s[3] = s3;
+}
@@ -0,0 +1,55 @@
+#ifndef GAMERANDOM_H
+#define GAMERANDOM_H
+
+#include <QtGlobal>
+
+// GameRandom is the source of random numbers of one game.
+// Unlike global rand(), each game owns its generator, so games can run in parallel threads and be replayed exactly:
+// the same seed gives the same dice, the same cards and the same decisions.
+// - generator is xoshiro256**, its state is filled from the seed by splitmix64, as its authors recommend;
+// - each Stream is the independent sequence, that starts 2^128 numbers away from the previous one (xoshiro jump),
+//   so, for example, additional card draws don't change the dice of the following turns;
+// - DICE is used for the die drops, CARDS for the card effects and their targets,
+//   AI for the decisions of computer players, SETUP for random filling of the board, hands and decks.
+
+class GameRandom
+{
+public:
+    enum class Stream {DICE, CARDS, AI, SETUP};
+    static constexpr int STREAMS_COUNT = 4;
+
+    explicit GameRandom(quint64 seed = 0);
+
+    // Seed:
+    // * randomSeed returns the seed taken from system entropy, for games, that should not repeat;
+    // * reseed restarts all the streams from the new seed, seed returns the recorded one.
+    static quint64 randomSeed ();
+    void    reseed (quint64 seed);
+    quint64 seed () const;
+
+    // Values:
+    // * next returns next raw 64-bit number of the stream;
+    // * bounded returns the value in range [low; high] without modulo bias;
+    // * index returns random index for the list with count elements;
+    // * chance returns true with probability of percent / 100 (random value in range [0; 100] is not greater than percent).
+    quint64 next    (Stream stream);
+    int     bounded (Stream stream, int low, int high);
+    int     index   (Stream stream, int count);
+    bool    chance  (Stream stream, int percent);
+
+private:
+    struct State
+    {
+        quint64 s[4];
+    };
+
+    static quint64 splitMix (quint64& x);
+    static quint64 rotl (quint64 x, int k);
+    static quint64 next (State& state);
+    static void    jump (State& state);
+
+    quint64 m_seed;
+    State   m_streams[STREAMS_COUNT];
+};
+
+#endif // GAMERANDOM_H
@@ -0,0 +1,91 @@
+#include "gamerules.h"
+
+#include <QtGlobal>
+
+int GameRules::dropDie(GameRandom &random, int low, int high)
+{
+    Q_ASSERT_X(low >= 0 && high <= 100 && low <= high, "GameRules::dropDie", "low should be greater than 0, high should be less than 100");
+
+    return random.bounded(GameRandom::Stream::DICE, low, high);
+}
+
+bool GameRules::chance(GameRandom &random, int percent)
+{
+    // Random value in range [0; 100] hits the chance, if it is not greater than percent.
+    return random.chance(GameRandom::Stream::CARDS, percent);
+}
+
+int GameRules::randomIndex(GameRandom &random, int count)
+{
+    Q_ASSERT_X(count > 0, "GameRules::randomIndex", "There should be at least one element to choose from.");
+
+    return random.index(GameRandom::Stream::CARDS, count);
+}
+
+int GameRules::treasureGold(GameRandom &random)
+{
+    // [5000; 10000] with a step of 500.
+    return 5000 + 500 * random.bounded(GameRandom::Stream::CARDS, 0, 10);
+}
+
+int GameRules::thiefGold(GameRandom &random)
+{
+    // [5000; 7500] with a step of 250.
+    return 5000 + 250 * random.bounded(GameRandom::Stream::CARDS, 0, 10);
+}
+
+int GameRules::bribeGold(GameRandom &random)
+{
+    // [2500; 5000] with a step of 250.
+    return 2500 + 250 * random.bounded(GameRandom::Stream::CARDS, 0, 10);
+}
+
+int GameRules::bribeTurns(GameRandom &random)
+{
+    // [1; 4] turns of jail with significantly lower chance to get more turns.
+    return 1 + random.bounded(GameRandom::Stream::CARDS, 0, random.bounded(GameRandom::Stream::CARDS, 0, 3));
+}
+
+int GameRules::halfRingSteps(int rows, int columns)
+{
+    return rows + columns - 1;
+}
+
+GameTypes::Direction GameRules::nextDirection(bool l, bool r, bool u, bool d, GameTypes::Direction direction, GameTypes::Constraint constraint)
+{
+    using Direction  = GameTypes::Direction;
+    using Constraint = GameTypes::Constraint;
+
+    // There are four types of corners.
+    // Player can approach them for two different sides.
+    // That means, he has direction in which he moves, and some type of corner. And needs to know, which direction to take next.
+    bool ulC = !u &&  r &&  d && !l;
+    bool urC = !u && !r &&  d &&  l;
+    bool lrC =  u && !r && !d &&  l;
+    bool llC =  u &&  r && !d && !l;
+
+    // upper left corner // upper right corner // lower left corner // lower right corner
+    // ** (left->down)   // ** (right->down)   // *  (left->up)     //  * (right->up)
+    // *  (up->right)    //  * (up->left)      // ** (down->right)  // ** (down->left)
+
+    // For clockwise movement, units move in sequence UPPER->RIGHT->BOTTOM->LEFT line.
+    if (constraint == Constraint::CLOCKWISE)
+    {
+        if (ulC) return (direction == Direction::LEFT)  ? Direction::DOWN : Direction::RIGHT;
+        if (urC) return (direction == Direction::RIGHT) ? Direction::DOWN : Direction::LEFT;
+        if (lrC) return (direction == Direction::RIGHT) ? Direction::UP   : Direction::LEFT;
+        if (llC) return (direction == Direction::LEFT)  ? Direction::UP   : Direction::RIGHT;
+    }
+
+    // For counter clockwise movement, units move in sequence LEFT->BOTTOM->RIGHT->UPPER line.
+    // As for counter clockwise movement, the affect of corner positions on next direction is a bit different.
+    if (constraint == Constraint::COUNTER_CLOCKWISE)
+    {
+        if (ulC) return (direction == Direction::UP)    ? Direction::RIGHT : Direction::DOWN;
+        if (urC) return (direction == Direction::RIGHT) ? Direction::DOWN  : Direction::LEFT;
+        if (lrC) return (direction == Direction::DOWN)  ? Direction::LEFT  : Direction::UP;
+        if (llC) return (direction == Direction::LEFT)  ? Direction::UP    : Direction::RIGHT;
+    }
+
+    return direction;
+}
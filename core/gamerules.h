@@ -0,0 +1,50 @@
+#ifndef GAMERULES_H
+#define GAMERULES_H
+
+#include "core/gametypes.h"
+#include "core/gamerandom.h"
+
+// GameRules holds the numbers and small decisions of the game, that are the same for the table and for the headless engine.
+// Keeping them in one place lets balance changes touch both the played and the simulated games at once.
+// - START_WAGE is the gold player receives for each passed circle;
+// - MAX_UPGRADE is the maximum count of stars any company can get;
+// - BIRTHDAY_GIFT is the gold each opponent presents to the player with birthday card;
+// - ..._CHANCE constants are the chances of success of the cards in percents.
+
+class GameRules
+{
+public:
+    static constexpr int START_WAGE    = 20000;
+    static constexpr int MAX_UPGRADE   = 3;
+    static constexpr int BIRTHDAY_GIFT = 5000;
+
+    static constexpr int MASTERCHEF_CHANCE = 100;
+    static constexpr int SABOTAGE_CHANCE   = 100;
+    static constexpr int RAID_CHANCE       = 100;
+    static constexpr int BRIBE_CHANCE      = 100;
+    static constexpr int SPY_CHANCE        = 100;
+
+    // Random values:
+    // All of them are taken from the generator of the game: the die uses its DICE stream, everything else - CARDS stream.
+    // * dropDie returns random value in range [low; high];
+    // * chance returns true with probability of percent / 100;
+    // * randomIndex returns random index for the list with count elements;
+    // * treasureGold, thiefGold and bribeGold return amounts of gold for relevant cards, bribeTurns - turns of imprisonment.
+    static int  dropDie (GameRandom& random, int low, int high);
+    static bool chance  (GameRandom& random, int percent);
+    static int  randomIndex (GameRandom& random, int count);
+
+    static int  treasureGold (GameRandom& random);
+    static int  thiefGold    (GameRandom& random);
+    static int  bribeGold    (GameRandom& random);
+    static int  bribeTurns   (GameRandom& random);
+
+    // Movement:
+    // * halfRingSteps returns count of steps to move half of the ring for FAST_AND_FURIOUS card;
+    // * nextDirection chooses the direction on corners of the ring based on the available neighbours (left, right, up, down),
+    //   current direction of the unit and the movement constraint. On straight lines the direction stays the same.
+    static int  halfRingSteps (int rows, int columns);
+    static GameTypes::Direction nextDirection (bool left, bool right, bool up, bool down, GameTypes::Direction direction, GameTypes::Constraint constraint);
+};
+
+#endif // GAMERULES_H
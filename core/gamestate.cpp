@@ -0,0 +1,354 @@
+#include "gamestate.h"
+
+#include <QDataStream>
+#include <QFileInfo>
+#include <QFile>
+#include <QDebug>
+
+#include "core/gamerules.h"
+
+#include <algorithm>
+
+namespace
+{
+    // Order of squares on the bitboard: by rows, then by columns.
+    bool before(const QPoint& a, const QPoint& b)
+    {
+        return (a.y() != b.y()) ? a.y() < b.y() : a.x() < b.x();
+    }
+}
+
+// ************************************************** COMPANY
+
+int GameState::Company::income() const
+{
+    int upgradeBonus = 0;
+    for (int i = 0; i < upgradeLevel && i < upgradeIncome.count(); ++i)
+        upgradeBonus += upgradeIncome.at(i);
+
+    return basicIncome + upgradeBonus;
+}
+
+int GameState::Company::upgradeCostForNextLevel() const
+{
+    if (isFullyUpgraded() || upgradeLevel >= upgradeCost.count())
+        return 0;
+
+    return upgradeCost.at(upgradeLevel);
+}
+
+bool GameState::Company::isFullyUpgraded() const
+{
+    return upgradeLevel >= GameRules::MAX_UPGRADE;
+}
+
+// ************************************************** STATE
+
+GameState::GameState(int rows, int columns)
+    : m_rows (rows),
+      m_columns (columns),
+      m_cellIndex (-1, columns, rows)
+{
+}
+
+bool GameState::loadMap(const QString &filename)
+{
+    // Map file has the same format, as the one table uses in saveTo method:
+    // count of nodes, then grid position of each node, flag of token availability and token itself (name, description, image path).
+    QFile file (filename);
+    if (!file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "Could not open the map file " << filename;
+        return false;
+    }
+
+    QDataStream stream (&file);
+
+    int nodesCount;
+    stream >> nodesCount;
+
+    m_cells.clear();
+    m_cellIndex.clear();
+    m_bits.clear();
+    m_ringDirty = true;
+    for (int i = 0; i < nodesCount; ++i)
+    {
+        QPoint position;
+        bool   tokenAvailable;
+        stream >> position >> tokenAvailable;
+
+        int cell = addCell(position);
+
+        if (tokenAvailable)
+        {
+            QString name, description, imagePath;
+            stream >> name >> description >> imagePath;
+
+            if (cell >= 0)
+                m_cells[cell].imageName = QFileInfo(imagePath.trimmed()).fileName();
+        }
+    }
+
+    file.close();
+    return (stream.status() == QDataStream::Ok);
+}
+
+void GameState::resolveTokens(const QList<Description*> &actionTokens, const QList<Description*> &ownershipTokens)
+{
+    for (int i = 0; i < m_cells.count(); ++i)
+    {
+        Cell& cell = m_cells[i];
+        if (cell.imageName.isEmpty() || cell.type != CellType::EMPTY)
+            continue;
+
+        for (int a = 0; a < actionTokens.count() && cell.type == CellType::EMPTY; ++a)
+        {
+            Description* d = actionTokens.at(a);
+            if (d->isKnownType() && d->imagePath() == cell.imageName)
+                setActionToken(i, d->actionType());
+        }
+
+        for (int o = 0; o < ownershipTokens.count() && cell.type == CellType::EMPTY; ++o)
+        {
+            Description* d = ownershipTokens.at(o);
+            if (d->imagePath() == cell.imageName)
+                setCompany(i, addCompany(d, o));
+        }
+    }
+}
+
+int GameState::addCell(const QPoint &gridPosition)
+{
+    if (cellAt(gridPosition) >= 0)
+        return -1;
+
+    Cell cell;
+    cell.gridPosition = gridPosition;
+    m_cells.append(cell);
+    m_cellIndex.set(gridPosition, m_cells.count() - 1);
+    m_bits.addNode(gridPosition);
+    m_ringDirty = true;
+
+    return m_cells.count() - 1;
+}
+
+int GameState::cellAt(const QPoint &gridPosition) const
+{
+    return m_cellIndex.at(gridPosition);
+}
+
+int GameState::findCell(GameTypes::ActionType actionType) const
+{
+    // The first node with the token is the lowest bit of its bitboard.
+    if (m_bits.isValid())
+    {
+        int square = m_bits.first(actionType);
+        return (square >= 0) ? cellAt(Bitboard::position(square)) : -1;
+    }
+
+    // Larger maps are scanned in the same order as squares are numbered: by rows, then by columns.
+    int found = -1;
+    for (int i = 0; i < m_cells.count(); ++i)
+    {
+        const Cell& cell = m_cells.at(i);
+        if (cell.type == CellType::ACTION && cell.actionType == actionType && (found < 0 || before(cell.gridPosition, m_cells.at(found).gridPosition)))
+            found = i;
+    }
+
+    return found;
+}
+
+QVector<int> GameState::findCells(GameTypes::ActionType actionType) const
+{
+    QVector<int> found;
+
+    // Each set bit of the bitboard is one cell, the lowest one is cleared after it has been taken.
+    if (m_bits.isValid())
+    {
+        for (quint64 board = m_bits.actions(actionType); board; board &= board - 1)
+            found.append(cellAt(Bitboard::position(Bitboard::first(board))));
+
+        return found;
+    }
+
+    for (int i = 0; i < m_cells.count(); ++i)
+    {
+        const Cell& cell = m_cells.at(i);
+        if (cell.type == CellType::ACTION && cell.actionType == actionType)
+            found.append(i);
+    }
+
+    std::sort(found.begin(), found.end(), [this](int a, int b) { return before(m_cells.at(a).gridPosition, m_cells.at(b).gridPosition); });
+    return found;
+}
+
+void GameState::setActionToken(int cell, GameTypes::ActionType actionType)
+{
+    Q_ASSERT_X(cell >= 0 && cell < m_cells.count(), "GameState::setActionToken", "Cell index is out of range.");
+
+    m_cells[cell].type = CellType::ACTION;
+    m_cells[cell].actionType = actionType;
+    m_cells[cell].company = -1;
+    m_bits.setAction(m_cells.at(cell).gridPosition, actionType);
+}
+
+void GameState::setCompany(int cell, int company)
+{
+    Q_ASSERT_X(cell >= 0 && cell < m_cells.count(), "GameState::setCompany", "Cell index is out of range.");
+
+    m_cells[cell].type = CellType::OWNERSHIP;
+    m_cells[cell].company = company;
+    m_companies[company].cell = cell;
+    m_bits.setCompany(m_cells.at(cell).gridPosition);
+}
+
+const BoardRing &GameState::ring() const
+{
+    if (m_ringDirty)
+    {
+        QVector<QPoint> gridPositions;
+        for (const Cell& cell : m_cells)
+            gridPositions.append(cell.gridPosition);
+
+        m_ring.compile(gridPositions);
+        m_ringDirty = false;
+    }
+
+    return m_ring;
+}
+
+int GameState::addCompany(Description *description, int descriptionIndex)
+{
+    Q_ASSERT_X(description->objectType() == Description::ObjectType::OWNERSHIP_TOKEN, "GameState::addCompany", "Description should belong to ownership token.");
+
+    Company company;
+    company.description   = descriptionIndex;
+    company.buyingCost    = description->buyingCost();
+    company.basicIncome   = description->basicIncome();
+    company.upgradeCost   = description->upgradeCost();
+    company.upgradeIncome = description->upgradeIncome();
+
+    m_companies.append(company);
+    return m_companies.count() - 1;
+}
+
+int GameState::addPlayer(const QString &name, int cell, int gold)
+{
+    PlayerState player;
+    player.name = name;
+    player.cell = cell;
+    player.gold = gold;
+
+    m_players.append(player);
+    m_unitBits.append((cell >= 0) ? Bitboard::bit(m_cells.at(cell).gridPosition) : 0);
+    m_ownedBits.append(0);
+    if (currentPlayer < 0)
+        currentPlayer = 0;
+
+    return m_players.count() - 1;
+}
+
+void GameState::addCard(GameTypes::CardType cardType)
+{
+    deck(GameTypes::isPositive(cardType)).prepend(cardType);
+}
+
+void GameState::movePlayer(int player, int cell)
+{
+    Q_ASSERT_X(player >= 0 && player < m_players.count(), "GameState::movePlayer", "Player index is out of range.");
+
+    m_players[player].cell = cell;
+    m_unitBits[player] = (cell >= 0) ? Bitboard::bit(m_cells.at(cell).gridPosition) : 0;
+}
+
+void GameState::setOwner(int company, int player)
+{
+    Q_ASSERT_X(company >= 0 && company < m_companies.count(), "GameState::setOwner", "Company index is out of range.");
+
+    Company& c = m_companies[company];
+    quint64 cell = (c.cell >= 0) ? Bitboard::bit(m_cells.at(c.cell).gridPosition) : 0;
+
+    if (c.owner >= 0)
+    {
+        m_players[c.owner].companies.removeOne(company);
+        m_ownedBits[c.owner] &= ~cell;
+    }
+
+    c.owner = player;
+
+    if (player >= 0)
+    {
+        m_players[player].companies.append(company);
+        m_ownedBits[player] |= cell;
+    }
+}
+
+const BoardBits &GameState::bits() const
+{
+    return m_bits;
+}
+
+quint64 GameState::units(int player) const
+{
+    return m_unitBits.at(player);
+}
+
+quint64 GameState::owned(int player) const
+{
+    return m_ownedBits.at(player);
+}
+
+int GameState::ownedCount(int player) const
+{
+    return Bitboard::count(m_ownedBits.at(player));
+}
+
+int GameState::rows() const
+{
+    return m_rows;
+}
+
+int GameState::columns() const
+{
+    return m_columns;
+}
+
+QVector<GameState::Cell> &GameState::cells()
+{
+    return m_cells;
+}
+
+QVector<GameState::Company> &GameState::companies()
+{
+    return m_companies;
+}
+
+QVector<GameState::PlayerState> &GameState::players()
+{
+    return m_players;
+}
+
+QVector<GameTypes::CardType> &GameState::deck(bool positive)
+{
+    return positive ? m_cardsP : m_cardsN;
+}
+
+const QVector<GameState::Cell> &GameState::cells() const
+{
+    return m_cells;
+}
+
+const QVector<GameState::Company> &GameState::companies() const
+{
+    return m_companies;
+}
+
+const QVector<GameState::PlayerState> &GameState::players() const
+{
+    return m_players;
+}
+
+const QVector<GameTypes::CardType> &GameState::deck(bool positive) const
+{
+    return positive ? m_cardsP : m_cardsN;
+}
@@ -0,0 +1,163 @@
+#ifndef GAMESTATE_H
+#define GAMESTATE_H
+
+#include <QString>
+#include <QVector>
+#include <QPoint>
+#include <QList>
+
+#include "core/gametypes.h"
+#include "core/description.h"
+#include "core/gridindex.h"
+#include "core/boardring.h"
+#include "core/bitboard.h"
+#include "core/gamerandom.h"
+
+// GameState is the plain model of a single game, that doesn't know anything about scenes, timers or painting.
+// It holds:
+// - cells of the board and the tokens placed on them;
+// - companies, that may be bought, upgraded and stolen, whether they lie on the board or in hands of players;
+// - players with their gold, positions, blocks and possessions;
+// - both decks of cards and the turn counters.
+// RulesEngine is the one who changes the state during the game, everyone else may read it freely.
+// Since there are no pointers between its parts (only indexes), the state can be copied to branch the game.
+
+class GameState
+{
+public:
+    enum class CellType {EMPTY, ACTION, OWNERSHIP};
+
+    // Cell is one node of the board.
+    // - imageName is the file name of the token image, that was stored in map file. Used to find the token in catalogs;
+    // - company is the index in the list of companies for ownership cells, -1 otherwise.
+    struct Cell
+    {
+        QPoint   gridPosition;
+        CellType type = CellType::EMPTY;
+        GameTypes::ActionType actionType = GameTypes::ActionType::START;
+        int      company = -1;
+        QString  imageName;
+    };
+
+    // Company is the ownership token with its economy.
+    // - description is the index of its description in the ownership tokens catalog;
+    // - cell is the index of the cell, where the company lies, -1 if it is not placed on the board;
+    // - owner is the index of the player, that bought the company, -1 if nobody did it yet.
+    struct Company
+    {
+        int description = -1;
+        int cell = -1;
+        int buyingCost  = 0;
+        int basicIncome = 0;
+        int upgradeLevel = 0;
+        int owner = -1;
+        QVector<int> upgradeCost;
+        QVector<int> upgradeIncome;
+
+        int  income() const;
+        int  upgradeCostForNextLevel() const;
+        bool isFullyUpgraded() const;
+    };
+
+    // PlayerState is everything the player has: position on the board, gold, possessions and penalties.
+    struct PlayerState
+    {
+        QString name;
+        int  cell = -1;
+        GameTypes::Direction direction = GameTypes::Direction::LEFT;
+        int  gold = 0;
+        int  rounds = 0;
+        int  blocked = 0;
+        bool incomeDoubled = false;
+        bool incomeStopped = false;
+        QVector<int> companies;
+        QVector<GameTypes::CardType> cards;
+    };
+
+    GameState(int rows = 8, int columns = 8);
+
+    // Board:
+    // * loadMap reads the cells from the map file, saved by the table (*.tm). Returns false, if the file can't be read;
+    // * resolveTokens finds the tokens of loaded cells in the catalogs using names of their images;
+    // * addCell places new empty cell at grid position, if it is not taken yet, and returns its index;
+    // * cellAt returns index of the cell at grid position or -1;
+    // * findCell returns index of the first cell with specific action token or -1, findCells returns all of them;
+    // * setActionToken and setCompany put the tokens on the cells;
+    // * ring returns the cells compiled into the ring of movement, it is recompiled after cells were added.
+    bool loadMap (const QString& filename);
+    void resolveTokens (const QList<Description*>& actionTokens, const QList<Description*>& ownershipTokens);
+    int  addCell (const QPoint& gridPosition);
+    int  cellAt  (const QPoint& gridPosition) const;
+    int  findCell(GameTypes::ActionType actionType) const;
+    QVector<int> findCells (GameTypes::ActionType actionType) const;
+    void setActionToken (int cell, GameTypes::ActionType actionType);
+    void setCompany     (int cell, int company);
+    const BoardRing& ring () const;
+
+    // Companies, players and cards:
+    // * addCompany creates the company using ownership token description and returns its index;
+    // * addPlayer places new player on specific cell with some start gold and returns its index;
+    // * addCard puts the card to the bottom of the relevant deck;
+    // * movePlayer places the unit of the player on another cell;
+    // * setOwner gives the company to another player (or takes it from everyone, if player is -1).
+    // Positions of units and owners of companies should be changed only by these methods, so bitboards stay actual.
+    int  addCompany (Description* description, int descriptionIndex);
+    int  addPlayer  (const QString& name, int cell, int gold);
+    void addCard    (GameTypes::CardType cardType);
+    void movePlayer (int player, int cell);
+    void setOwner   (int company, int player);
+
+    // Bitboards:
+    // * bits returns the bitboards of nodes and tokens;
+    // * units and owned return the sets of cells with the unit and with companies of specific player;
+    // * ownedCount returns count of companies of the player, that lie on the board.
+    // All of them are valid only if bits().isValid() is true, i.e. the board fits 8x8 grid.
+    const BoardBits& bits () const;
+    quint64 units (int player) const;
+    quint64 owned (int player) const;
+    int     ownedCount (int player) const;
+
+    int rows() const;
+    int columns() const;
+
+    QVector<Cell>& cells();
+    QVector<Company>& companies();
+    QVector<PlayerState>& players();
+    QVector<GameTypes::CardType>& deck(bool positive);
+
+    const QVector<Cell>& cells() const;
+    const QVector<Company>& companies() const;
+    const QVector<PlayerState>& players() const;
+    const QVector<GameTypes::CardType>& deck(bool positive) const;
+
+    // Turn counters:
+    // - currentPlayer is the index of player, who makes the turn now;
+    // - stepsLeft is the count of steps left for the moving unit;
+    // - turn is the count of turns made since the beginning of the game;
+    // - constraintCurrent and constraintDefault are the actual and usual order of movement around the ring;
+    // - random is the generator of this game, its seed is enough to replay the game from the same start state.
+    int currentPlayer = -1;
+    int stepsLeft = 0;
+    int turn = 0;
+    GameTypes::Constraint constraintCurrent = GameTypes::Constraint::COUNTER_CLOCKWISE;
+    GameTypes::Constraint constraintDefault = GameTypes::Constraint::COUNTER_CLOCKWISE;
+    GameRandom random;
+
+private:
+    int m_rows;
+    int m_columns;
+
+    QVector<Cell>        m_cells;
+    GridIndex<int>       m_cellIndex; // indexes of cells by their grid positions, -1 for free positions
+    BoardBits            m_bits;
+    QVector<quint64>     m_unitBits;   // cells with units, one bitboard per player
+    QVector<quint64>     m_ownedBits;  // cells with owned companies, one bitboard per player
+    mutable BoardRing    m_ring;
+    mutable bool         m_ringDirty = true;
+    QVector<Company>     m_companies;
+    QVector<PlayerState> m_players;
+    QVector<GameTypes::CardType> m_cardsP;
+    QVector<GameTypes::CardType> m_cardsN;
+};
+
+#endif // GAMESTATE_H
@@ -0,0 +1,118 @@
+#include "gametypes.h"
+
+namespace
+{
+    // Names of the types in the same order as enumeration values.
+    const char* const ACTION_NAMES[GameTypes::ACTION_TYPES_COUNT] =
+        {"start", "portal", "prison", "exchange", "move_forward", "move_backward", "card_positive", "card_negative"};
+
+    const char* const CARD_NAMES[GameTypes::CARD_TYPES_COUNT] =
+        {"treasure", "overtime", "masterchef", "fast_and_furious", "birthday", "scientist", "together",
+         "thief", "diversion", "sabotage", "raid", "bribe", "sneak", "spy"};
+}
+
+QString GameTypes::actionTypeToString(ActionType type)
+{
+    return QString(ACTION_NAMES[static_cast<int>(type)]);
+}
+
+GameTypes::ActionType GameTypes::stringToActionType(const QString &name, bool *ok)
+{
+    QString trimmed = name.trimmed();
+
+    for (int i = 0; i < ACTION_TYPES_COUNT; ++i)
+    {
+        if (trimmed == QLatin1String(ACTION_NAMES[i]))
+        {
+            if (ok) *ok = true;
+            return static_cast<ActionType>(i);
+        }
+    }
+
+    if (ok) *ok = false;
+    return ActionType::START;
+}
+
+QString GameTypes::cardTypeToString(CardType type)
+{
+    if (type == CardType::DEFAULT)
+        return "";
+
+    return QString(CARD_NAMES[static_cast<int>(type)]);
+}
+
+GameTypes::CardType GameTypes::stringToCardType(const QString &name)
+{
+    QString trimmed = name.trimmed();
+
+    for (int i = 0; i < CARD_TYPES_COUNT; ++i)
+        if (trimmed == QLatin1String(CARD_NAMES[i]))
+            return static_cast<CardType>(i);
+
+    return CardType::DEFAULT;
+}
+
+QPoint GameTypes::directionToVector(Direction direction)
+{
+    switch (direction)
+    {
+        case Direction::NO_MOVE:    return QPoint( 0, 0);
+        case Direction::UP:         return QPoint( 0,-1);
+        case Direction::LEFT:       return QPoint(-1, 0);
+        case Direction::RIGHT:      return QPoint( 1, 0);
+        case Direction::DOWN:       return QPoint( 0, 1);
+        case Direction::LEFT_UP:    return QPoint(-1,-1);
+        case Direction::LEFT_DOWN:  return QPoint(-1, 1);
+        case Direction::RIGHT_UP:   return QPoint( 1,-1);
+        case Direction::RIGHT_DOWN: return QPoint( 1, 1);
+    }
+
+    return QPoint();
+}
+
+GameTypes::Direction GameTypes::vectorToDirection(const QPoint &vector)
+{
+    static const Direction directions[] = {Direction::LEFT, Direction::UP, Direction::RIGHT, Direction::DOWN,
+                                           Direction::LEFT_UP, Direction::LEFT_DOWN, Direction::RIGHT_UP, Direction::RIGHT_DOWN};
+
+    for (Direction direction : directions)
+        if (directionToVector(direction) == vector)
+            return direction;
+
+    return Direction::NO_MOVE;
+}
+
+GameTypes::Direction GameTypes::opposite(Direction direction)
+{
+    switch (direction)
+    {
+        case Direction::LEFT:       return Direction::RIGHT;
+        case Direction::RIGHT:      return Direction::LEFT;
+        case Direction::UP:         return Direction::DOWN;
+        case Direction::DOWN:       return Direction::UP;
+        case Direction::LEFT_UP:    return Direction::RIGHT_DOWN;
+        case Direction::RIGHT_DOWN: return Direction::LEFT_UP;
+        case Direction::LEFT_DOWN:  return Direction::RIGHT_UP;
+        case Direction::RIGHT_UP:   return Direction::LEFT_DOWN;
+        case Direction::NO_MOVE:    return Direction::NO_MOVE;
+    }
+
+    return Direction::NO_MOVE;
+}
+
+GameTypes::Constraint GameTypes::opposite(Constraint constraint)
+{
+    switch (constraint)
+    {
+        case Constraint::CLOCKWISE:         return Constraint::COUNTER_CLOCKWISE;
+        case Constraint::COUNTER_CLOCKWISE: return Constraint::CLOCKWISE;
+        case Constraint::UNCONSTRAINED:     return Constraint::UNCONSTRAINED;
+    }
+
+    return Constraint::UNCONSTRAINED;
+}
+
+bool GameTypes::isPositive(CardType type)
+{
+    return static_cast<int>(type) <= static_cast<int>(CardType::TOGETHER);
+}
@@ -0,0 +1,44 @@
+#ifndef GAMETYPES_H
+#define GAMETYPES_H
+
+#include <QString>
+#include <QPoint>
+
+// GameTypes gathers the enumerations, that are shared between the rules core and the widget application.
+// Tokens, cards, units and table use aliases to these, so both sides speak about the same values:
+// - ActionType is the kind of the action token, that is activated when player hits the node;
+// - CardType is the kind of the bonus card, positive ones go first, negative ones follow them;
+// - Direction is the way unit moves on the grid (diagonals are used only for neighbours checks);
+// - Constraint is the order, in which units walk around the ring of nodes.
+// String conversions use the same names as the type tags in XML files of tokens and cards.
+
+class GameTypes
+{
+public:
+    enum class ActionType {START, PORTAL, PRISON, EXCHANGE, MOVE_FORWARD, MOVE_BACKWARD, CARD_POSITIVE, CARD_NEGATIVE};
+    enum class CardType   {TREASURE, OVERTIME, MASTERCHEF, FAST_AND_FURIOUS, BIRTHDAY, SCIENTIST, TOGETHER,
+                           THIEF, DIVERSION, SABOTAGE, RAID, BRIBE, SNEAK, SPY,
+                           DEFAULT};
+    enum class Direction  {LEFT, UP, RIGHT, DOWN, LEFT_UP, LEFT_DOWN, RIGHT_UP, RIGHT_DOWN, NO_MOVE};
+    enum class Constraint {CLOCKWISE, COUNTER_CLOCKWISE, UNCONSTRAINED};
+
+    static constexpr int ACTION_TYPES_COUNT = 8;
+    static constexpr int CARD_TYPES_COUNT   = 14;
+
+    // Conversions:
+    // * actionTypeToString and stringToActionType convert action types to their XML names and back, ok is set to false for unknown names;
+    // * cardTypeToString and stringToCardType do the same for cards, unknown names become CardType::DEFAULT;
+    // * directionToVector returns grid shift for one step in specific direction, vectorToDirection does the opposite (NO_MOVE for longer shifts);
+    // * opposite returns the direction, that leads back.
+    static QString    actionTypeToString (ActionType type);
+    static ActionType stringToActionType (const QString& name, bool* ok = nullptr);
+    static QString    cardTypeToString   (CardType type);
+    static CardType   stringToCardType   (const QString& name);
+    static QPoint     directionToVector  (Direction direction);
+    static Direction  vectorToDirection  (const QPoint& vector);
+    static Direction  opposite (Direction direction);
+    static Constraint opposite (Constraint constraint);
+    static bool       isPositive (CardType type);
+};
+
+#endif // GAMETYPES_H
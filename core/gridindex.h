@@ -0,0 +1,128 @@
+#ifndef GRIDINDEX_H
+#define GRIDINDEX_H
+
+#include <QVector>
+#include <QPoint>
+#include <QRect>
+
+// GridIndex is the dense storage of values by grid positions.
+// The board is a small rectangle of cells, so a flat array of rows * columns slots lets any lookup take constant time,
+// instead of scanning the whole list of nodes (or cells) and comparing their grid positions.
+// - slots, that hold nothing, contain the empty value, given to constructor (nullptr for pointers, -1 for indexes etc.);
+// - the index grows by itself, when a value is placed outside of its bounds (custom maps may be larger than default 8x8 board),
+//   positions outside of the bounds are simply empty for lookups.
+// The index stores values only, the owner (table or game state) is responsible for keeping it in sync with its lists.
+
+template <typename T>
+class GridIndex
+{
+public:
+    // Bits of the neighbours mask use the same sequence, as the neighbours bit array of the table: L-R-U-D-LU-LD-RU-RD.
+    enum Neighbour : quint8
+    {
+        LEFT       = 1 << 0,
+        RIGHT      = 1 << 1,
+        UP         = 1 << 2,
+        DOWN       = 1 << 3,
+        LEFT_UP    = 1 << 4,
+        LEFT_DOWN  = 1 << 5,
+        RIGHT_UP   = 1 << 6,
+        RIGHT_DOWN = 1 << 7
+    };
+
+    explicit GridIndex(const T& empty = T(), int columns = 0, int rows = 0)
+        : m_empty (empty)
+    {
+        reset(columns, rows);
+    }
+
+    // Storage:
+    // * reset drops all the values and sets the bounds to [0; columns) x [0; rows);
+    // * clear drops all the values, keeping the bounds;
+    // * set places the value at grid position, growing the bounds if needed;
+    // * remove empties the slot at grid position;
+    // * at returns the value at grid position or the empty value;
+    // * contains returns true, if there is a value at grid position;
+    // * neighbours returns the mask of taken slots around the grid position.
+    void reset (int columns, int rows)
+    {
+        m_bounds = QRect(0, 0, qMax(columns, 0), qMax(rows, 0));
+        m_slots.fill(m_empty, m_bounds.width() * m_bounds.height());
+    }
+
+    void clear ()
+    {
+        m_slots.fill(m_empty);
+    }
+
+    void set (const QPoint& gridPosition, const T& value)
+    {
+        if (!m_bounds.contains(gridPosition))
+            grow(gridPosition);
+
+        m_slots[slot(gridPosition)] = value;
+    }
+
+    void remove (const QPoint& gridPosition)
+    {
+        if (m_bounds.contains(gridPosition))
+            m_slots[slot(gridPosition)] = m_empty;
+    }
+
+    T at (const QPoint& gridPosition) const
+    {
+        return m_bounds.contains(gridPosition) ? m_slots.at(slot(gridPosition)) : m_empty;
+    }
+
+    bool contains (const QPoint& gridPosition) const
+    {
+        return !(at(gridPosition) == m_empty);
+    }
+
+    quint8 neighbours (const QPoint& gridPosition) const
+    {
+        quint8 mask = 0;
+
+        if (contains(gridPosition + QPoint(-1, 0)))  mask |= LEFT;
+        if (contains(gridPosition + QPoint( 1, 0)))  mask |= RIGHT;
+        if (contains(gridPosition + QPoint( 0,-1)))  mask |= UP;
+        if (contains(gridPosition + QPoint( 0, 1)))  mask |= DOWN;
+        if (contains(gridPosition + QPoint(-1,-1)))  mask |= LEFT_UP;
+        if (contains(gridPosition + QPoint(-1, 1)))  mask |= LEFT_DOWN;
+        if (contains(gridPosition + QPoint( 1,-1)))  mask |= RIGHT_UP;
+        if (contains(gridPosition + QPoint( 1, 1)))  mask |= RIGHT_DOWN;
+
+        return mask;
+    }
+
+    const QRect& bounds() const
+    {
+        return m_bounds;
+    }
+
+private:
+    int slot (const QPoint& gridPosition) const
+    {
+        return (gridPosition.y() - m_bounds.top()) * m_bounds.width() + (gridPosition.x() - m_bounds.left());
+    }
+
+    void grow (const QPoint& gridPosition)
+    {
+        // New bounds include the old ones and the position, values are copied to their new slots.
+        QRect bounds = m_bounds.isEmpty() ? QRect(gridPosition, QSize(1,1)) : m_bounds.united(QRect(gridPosition, QSize(1,1)));
+
+        QVector<T> grown (bounds.width() * bounds.height(), m_empty);
+        for (int y = m_bounds.top(); y <= m_bounds.bottom() && !m_bounds.isEmpty(); ++y)
+            for (int x = m_bounds.left(); x <= m_bounds.right(); ++x)
+                grown[(y - bounds.top()) * bounds.width() + (x - bounds.left())] = m_slots.at(slot(QPoint(x,y)));
+
+        m_bounds = bounds;
+        m_slots  = grown;
+    }
+
+    T          m_empty;
+    QRect      m_bounds;
+    QVector<T> m_slots;
+};
+
+#endif // GRIDINDEX_H
@@ -0,0 +1,569 @@
+#include "rulesengine.h"
+
+#include <QtGlobal>
+
+#include "core/gamerules.h"
+
+using ActionType = GameTypes::ActionType;
+using CardType   = GameTypes::CardType;
+using CellType   = GameState::CellType;
+
+RulesEngine::RulesEngine(GameState *state)
+    : m_state (state)
+    , m_cardActivations (GameTypes::CARD_TYPES_COUNT, 0)
+{
+    Q_ASSERT_X(m_state != nullptr, "RulesEngine::RulesEngine", "Engine needs the state to play on.");
+}
+
+void RulesEngine::setPolicy(const Policy &policy)
+{
+    m_policy = policy;
+}
+
+const RulesEngine::Policy &RulesEngine::policy() const
+{
+    return m_policy;
+}
+
+GameState *RulesEngine::state() const
+{
+    return m_state;
+}
+
+const QVector<int> &RulesEngine::cardActivations() const
+{
+    return m_cardActivations;
+}
+
+// ****************************************************** GAME FLOW
+
+void RulesEngine::turn()
+{
+    // There should be at least two players to play the game.
+    if (m_state->players().count() < 2)
+        return;
+
+    nextPlayer();
+    ++m_state->turn;
+
+    // If player is in prison, he can not move for some turns, the block is served by his own turns only.
+    int player = m_state->currentPlayer;
+    GameState::PlayerState& p = m_state->players()[player];
+    if (p.blocked > 0)
+        --p.blocked;
+    else
+        move(player, GameRules::dropDie(m_state->random, 1, 6));
+
+    if (m_policy.useCards)
+        useCards(player);
+}
+
+int RulesEngine::play(int maxTurns, int circlesToFinish)
+{
+    while (m_state->turn < maxTurns && !isOver(circlesToFinish))
+        turn();
+
+    return leader();
+}
+
+bool RulesEngine::isOver(int circlesToFinish) const
+{
+    const QVector<GameState::PlayerState>& players = m_state->players();
+    for (int i = 0; i < players.count(); ++i)
+        if (players.at(i).rounds >= circlesToFinish)
+            return true;
+
+    return false;
+}
+
+int RulesEngine::leader() const
+{
+    const QVector<GameState::PlayerState>& players = m_state->players();
+
+    int leader = -1;
+    for (int i = 0; i < players.count(); ++i)
+        if (leader < 0 || players.at(i).gold > players.at(leader).gold)
+            leader = i;
+
+    return leader;
+}
+
+void RulesEngine::nextPlayer()
+{
+    // Choose index on a circular basis.
+    m_state->currentPlayer = (m_state->currentPlayer + 1) % m_state->players().count();
+}
+
+// ****************************************************** MOVEMENT
+
+void RulesEngine::move(int player, int steps, bool resolveLanding)
+{
+    GameState::PlayerState& p = m_state->players()[player];
+    if (m_movementDepth >= MAX_MOVEMENT_DEPTH || p.cell < 0)
+        return;
+
+    ++m_movementDepth;
+
+    // When movement constraint differs from the default one (backward movement), it is used for this move only.
+    bool reversed = (m_state->constraintCurrent != m_state->constraintDefault);
+
+    // Give rewards for passed circle even if it is not the end node for current move.
+    // On the closed ring the landing cell and passed start nodes are calculated at once,
+    // otherwise the unit goes step by step.
+    const BoardRing& ring = m_state->ring();
+    int from = ring.indexOf(m_state->cells().at(p.cell).gridPosition);
+
+    if (from >= 0 && m_state->constraintCurrent != GameTypes::Constraint::UNCONSTRAINED)
+    {
+        int crossings = 0;
+        for (int start : m_state->findCells(ActionType::START))
+            crossings += ring.passes(from, steps, m_state->constraintCurrent, ring.indexOf(m_state->cells().at(start).gridPosition));
+
+        int to = ring.advance(from, steps, m_state->constraintCurrent);
+        p.direction = ring.direction(ring.advance(to, -1, m_state->constraintCurrent), m_state->constraintCurrent);
+        m_state->movePlayer(player, m_state->cellAt(ring.at(to)));
+
+        for (int i = 0; i < crossings; ++i)
+            passStart(player);
+    }
+    else
+    {
+        m_state->stepsLeft = steps;
+        while (m_state->stepsLeft > 0 && step(player))
+        {
+            const GameState::Cell& cell = m_state->cells().at(p.cell);
+            if (cell.type == CellType::ACTION && cell.actionType == ActionType::START)
+                passStart(player);
+        }
+    }
+    m_state->stepsLeft = 0;
+
+    // Default the movement constraint.
+    if (reversed)
+        m_state->constraintCurrent = m_state->constraintDefault;
+
+    if (resolveLanding)
+        resolveCell(player);
+
+    --m_movementDepth;
+}
+
+bool RulesEngine::step(int player)
+{
+    GameState::PlayerState& p = m_state->players()[player];
+    QPoint position = m_state->cells().at(p.cell).gridPosition;
+
+    // On the closed ring the next cell is known in advance.
+    const BoardRing& ring = m_state->ring();
+    if (ring.isClosed())
+    {
+        int index = ring.indexOf(position);
+        int next  = ring.next(index, m_state->constraintCurrent);
+        if (next < 0)
+            return false;
+
+        p.direction = ring.direction(index, m_state->constraintCurrent);
+        m_state->movePlayer(player, m_state->cellAt(ring.at(next)));
+        --m_state->stepsLeft;
+
+        return true;
+    }
+
+    // Otherwise direction is chosen on corners by the neighbours of the cell.
+    bool l = m_state->cellAt(position + QPoint(-1, 0)) >= 0;
+    bool r = m_state->cellAt(position + QPoint( 1, 0)) >= 0;
+    bool u = m_state->cellAt(position + QPoint( 0,-1)) >= 0;
+    bool d = m_state->cellAt(position + QPoint( 0, 1)) >= 0;
+
+    p.direction = GameRules::nextDirection(l, r, u, d, p.direction, m_state->constraintCurrent);
+
+    int next = m_state->cellAt(position + GameTypes::directionToVector(p.direction));
+    if (next < 0)
+        return false;
+
+    m_state->movePlayer(player, next);
+    --m_state->stepsLeft;
+
+    return true;
+}
+
+// ****************************************************** INTERACTIONS
+
+void RulesEngine::resolveCell(int player)
+{
+    const GameState::PlayerState& p = m_state->players().at(player);
+    const GameState::Cell& cell = m_state->cells().at(p.cell);
+
+    switch (cell.type)
+    {
+        // Start node has been paid already, when unit passed it.
+        case CellType::ACTION:
+        if (cell.actionType != ActionType::START)
+            action(player, cell.actionType);
+        break;
+
+        case CellType::OWNERSHIP:
+        {
+            const GameState::Company& company = m_state->companies().at(cell.company);
+
+            if (company.owner < 0 && m_policy.buyCompanies)
+                buy(player, cell.company);
+            else if (company.owner == player && m_policy.upgradeCompanies)
+                upgrade(cell.company, false);
+        }
+        break;
+
+        case CellType::EMPTY:
+        break;
+    }
+}
+
+void RulesEngine::action(int player, GameTypes::ActionType actionType)
+{
+    // Keep in step with Table::action, the table applies the same effects to its scene.
+    GameState::PlayerState& p = m_state->players()[player];
+
+    switch (actionType)
+    {
+    // Give player the wage and returns from his companies.
+    case ActionType::START:
+        passStart(player);
+        break;
+
+    // Move player to the start node and activate start action.
+    case ActionType::PORTAL:
+        {
+            int start = m_state->findCell(ActionType::START);
+            if (start >= 0)
+            {
+                m_state->movePlayer(player, start);
+                passStart(player);
+            }
+        }
+        break;
+
+    // Block player for 1 turn.
+    case ActionType::PRISON:
+        p.blocked = 1;
+        break;
+
+    // Trading zone is not implemented yet.
+    case ActionType::EXCHANGE:
+        break;
+
+    case ActionType::MOVE_FORWARD:
+        move(player, GameRules::dropDie(m_state->random, 1, 6));
+        break;
+
+    // Set opposite direction and leave everything else like in moving forwards technique.
+    case ActionType::MOVE_BACKWARD:
+        m_state->constraintCurrent = GameTypes::opposite(m_state->constraintCurrent);
+        move(player, GameRules::dropDie(m_state->random, 1, 6));
+        break;
+
+    case ActionType::CARD_POSITIVE:
+    case ActionType::CARD_NEGATIVE:
+        {
+            QVector<CardType>& deck = m_state->deck(actionType == ActionType::CARD_POSITIVE);
+            if (!deck.isEmpty())
+                p.cards.append(deck.takeLast());
+        }
+        break;
+    }
+}
+
+bool RulesEngine::activate(int player, GameTypes::CardType cardType)
+{
+    // Keep in step with Table::activate, the table applies the same effects to its scene.
+    QVector<GameState::PlayerState>& players = m_state->players();
+    bool cardActivated = true;
+
+    switch (cardType)
+    {
+    // Positive cards
+    case CardType::TREASURE:
+        players[player].gold += GameRules::treasureGold(m_state->random);
+        break;
+
+    case CardType::OVERTIME:
+        players[player].incomeDoubled = true;
+        break;
+
+    case CardType::MASTERCHEF:
+        {
+            int steps = GameRules::dropDie(m_state->random, 1, 6);
+            if (GameRules::chance(m_state->random, GameRules::MASTERCHEF_CHANCE))
+                steps *= 2;
+
+            move(player, steps);
+        }
+        break;
+
+    case CardType::FAST_AND_FURIOUS:
+        move(player, GameRules::halfRingSteps(m_state->rows(), m_state->columns()));
+        break;
+
+    case CardType::BIRTHDAY:
+        for (int i = 0; i < players.count(); ++i)
+            if (i != player)
+                transferGold(i, player, qMin(GameRules::BIRTHDAY_GIFT, players.at(i).gold));
+        break;
+
+    case CardType::SCIENTIST:
+        upgradeRandomCompany(player, 1);
+        break;
+
+    case CardType::TOGETHER:
+        {
+            // All the players make the same count of steps, even the ones in prison, but only the current one holds the turn.
+            int steps = GameRules::dropDie(m_state->random, 6, 12);
+            for (int i = 0; i < players.count(); ++i)
+                move(i, steps, false);
+        }
+        break;
+
+    // Negative cards
+    case CardType::THIEF:
+        {
+            int opponent = randomOpponent(player);
+            if (opponent >= 0)
+                transferGold(opponent, player, qMin(GameRules::thiefGold(m_state->random), players.at(opponent).gold));
+            else
+                cardActivated = false;
+        }
+        break;
+
+    case CardType::DIVERSION:
+        {
+            // Opponent walks backwards and the node he ended on is resolved, opponent in prison stays where he is.
+            int opponent = randomOpponent(player);
+            if (opponent >= 0)
+            {
+                if (players.at(opponent).blocked == 0)
+                {
+                    m_state->constraintCurrent = GameTypes::opposite(m_state->constraintCurrent);
+                    move(opponent, GameRules::dropDie(m_state->random, 1, 6));
+                }
+            }
+            else
+                cardActivated = false;
+        }
+        break;
+
+    case CardType::SABOTAGE:
+        for (int i = 0; i < players.count(); ++i)
+            if (i != player && GameRules::chance(m_state->random, GameRules::SABOTAGE_CHANCE))
+                players[i].incomeStopped = true;
+        break;
+
+    case CardType::RAID:
+        if (GameRules::chance(m_state->random, GameRules::RAID_CHANCE))
+        {
+            int opponent = randomOpponent(player);
+            int company  = (opponent >= 0) ? randomCompany(opponent) : -1;
+
+            if (company >= 0)
+            {
+                m_state->setOwner(company, player);
+            }
+            else
+                cardActivated = false;
+        }
+        break;
+
+    case CardType::BRIBE:
+        {
+            int gold = GameRules::bribeGold(m_state->random);
+            if (players.at(player).gold < gold)
+            {
+                cardActivated = false;
+                break;
+            }
+
+            if (GameRules::chance(m_state->random, GameRules::BRIBE_CHANCE))
+            {
+                int prison   = m_state->findCell(ActionType::PRISON);
+                int opponent = randomOpponent(player);
+
+                if (prison >= 0 && opponent >= 0)
+                {
+                    players[player].gold -= gold;
+                    m_state->movePlayer(opponent, prison);
+                    players[opponent].blocked = GameRules::bribeTurns(m_state->random);
+                }
+                else
+                    cardActivated = false;
+            }
+        }
+        break;
+
+    case CardType::SNEAK:
+        {
+            int opponent = randomOpponent(player);
+            if (opponent >= 0)
+                m_state->movePlayer(player, players.at(opponent).cell);
+            else
+                cardActivated = false;
+        }
+        break;
+
+    case CardType::SPY:
+        if (GameRules::chance(m_state->random, GameRules::SPY_CHANCE))
+        {
+            int opponent = randomOpponent(player);
+            int stars = (opponent >= 0) ? topCompanyUpgradeLevel(opponent) : 0;
+
+            if (stars > 0)
+                upgradeRandomCompany(player, stars);
+            else
+                cardActivated = false;
+        }
+        break;
+
+    case CardType::DEFAULT:
+        break;
+    }
+
+    return cardActivated;
+}
+
+bool RulesEngine::buy(int player, int company)
+{
+    GameState::PlayerState& p = m_state->players()[player];
+    GameState::Company& c = m_state->companies()[company];
+
+    if (c.owner >= 0 || p.gold < c.buyingCost)
+        return false;
+
+    p.gold -= c.buyingCost;
+    m_state->setOwner(company, player);
+
+    return true;
+}
+
+bool RulesEngine::upgrade(int company, bool bonus)
+{
+    GameState::Company& c = m_state->companies()[company];
+    if (c.isFullyUpgraded())
+        return false;
+
+    // Upgrades, that are not bonuses, should be paid by the owner.
+    if (!bonus)
+    {
+        if (c.owner < 0)
+            return false;
+
+        int cost = c.upgradeCostForNextLevel();
+        GameState::PlayerState& owner = m_state->players()[c.owner];
+        if (owner.gold < cost)
+            return false;
+
+        owner.gold -= cost;
+    }
+
+    ++c.upgradeLevel;
+    return true;
+}
+
+// ****************************************************** HELPERS
+
+void RulesEngine::passStart(int player)
+{
+    GameState::PlayerState& p = m_state->players()[player];
+
+    ++p.rounds;                       // passed circles stats
+    p.gold += GameRules::START_WAGE;  // wage per passed circle
+    p.gold += returns(player);        // returns from the ownings
+}
+
+void RulesEngine::useCards(int player)
+{
+    // Cards, that could not be activated, stay in hand until better times.
+    // Cards taken during activation of others (masterchef moved player to card node, for example) are used too.
+    int i = 0;
+    while (i < m_state->players().at(player).cards.count())
+    {
+        CardType cardType = m_state->players().at(player).cards.at(i);
+
+        if (activate(player, cardType))
+        {
+            m_state->players()[player].cards.removeAt(i);
+            ++m_cardActivations[static_cast<int>(cardType)];
+        }
+        else
+            ++i;
+    }
+}
+
+void RulesEngine::transferGold(int from, int to, int gold)
+{
+    if (gold <= 0)
+        return;
+
+    m_state->players()[from].gold -= gold;
+    m_state->players()[to].gold   += gold;
+}
+
+void RulesEngine::upgradeRandomCompany(int player, int stars)
+{
+    int company = randomCompany(player);
+    if (company < 0)
+        return;
+
+    for (int i = 0; i < stars; ++i)
+        upgrade(company, true);
+}
+
+int RulesEngine::returns(int player)
+{
+    GameState::PlayerState& p = m_state->players()[player];
+
+    int returns = 0;
+    for (int i = 0; i < p.companies.count(); ++i)
+        returns += m_state->companies().at(p.companies.at(i)).income();
+
+    if (p.incomeDoubled)
+    {
+        returns *= 2;
+        p.incomeDoubled = false;
+    }
+
+    if (p.incomeStopped)
+    {
+        returns = 0;
+        p.incomeStopped = false;
+    }
+
+    return returns;
+}
+
+int RulesEngine::randomOpponent(int player) const
+{
+    int count = m_state->players().count();
+    if (count < 2)
+        return -1;
+
+    // Choose among all the players except the one, who asks.
+    int opponent = GameRules::randomIndex(m_state->random, count - 1);
+    return (opponent >= player) ? opponent + 1 : opponent;
+}
+
+int RulesEngine::randomCompany(int player) const
+{
+    const QVector<int>& companies = m_state->players().at(player).companies;
+    if (companies.isEmpty())
+        return -1;
+
+    return companies.at(GameRules::randomIndex(m_state->random, companies.count()));
+}
+
+int RulesEngine::topCompanyUpgradeLevel(int player) const
+{
+    const QVector<int>& companies = m_state->players().at(player).companies;
+
+    int top = 0;
+    for (int i = 0; i < companies.count(); ++i)
+        top = qMax(top, m_state->companies().at(companies.at(i)).upgradeLevel);
+
+    return top;
+}
@@ -0,0 +1,86 @@
+#ifndef RULESENGINE_H
+#define RULESENGINE_H
+
+#include "core/gamestate.h"
+
+// RulesEngine plays the game on the GameState without any scene, timers or painting.
+// It is the headless model of the Table: the same turn, movement, action tokens and cards,
+// only resolved synchronously, so thousands of games can be played at CPU speed.
+// The table doesn't use it, it has its own implementation of the effects on scene items,
+// so each change of rules should be made in both places (see action, activate and passStart of Table).
+// Decisions, that are made by the user in the table (buying, upgrading, using the cards), are made by the Policy here.
+
+class RulesEngine
+{
+public:
+    // Policy describes, what players do when there is a choice:
+    // - buyCompanies: buy free company, if player stands on it and has enough gold;
+    // - upgradeCompanies: upgrade own company, if player stands on it and has enough gold;
+    // - useCards: use all the cards from the hand at the end of the turn.
+    struct Policy
+    {
+        bool buyCompanies     = true;
+        bool upgradeCompanies = true;
+        bool useCards         = true;
+    };
+
+    explicit RulesEngine(GameState* state);
+
+    void setPolicy (const Policy& policy);
+    const Policy& policy() const;
+    GameState* state() const;
+
+    // Game flow:
+    // * turn passes the turn to next player, drops the die, moves his unit, resolves the node and uses the cards;
+    // * play makes turns until maxTurns are made or someone passes circlesToFinish circles, returns index of the leader;
+    // * isOver returns true, if someone has passed circlesToFinish circles;
+    // * leader returns index of the richest player.
+    void turn ();
+    int  play (int maxTurns, int circlesToFinish);
+    bool isOver (int circlesToFinish) const;
+    int  leader () const;
+
+    // Rules:
+    // These are the counterparts of Table methods with the same names, they should give the same results.
+    // * move makes specific count of steps with the unit, paying the wage for each passed start node,
+    //   and resolves the node it ended on, if resolveLanding is true. On the closed ring the move is calculated at once.
+    //   Prison doesn't stop it, the block is checked and served by turn;
+    // * step makes one step around the ring according to current movement constraint, returns false if there is no way;
+    // * action applies the action token effect to the player;
+    // * activate applies the card effect, returns false if the card could not be activated and should stay in hand;
+    // * buy and upgrade work with companies, return false if there is not enough gold.
+    void move     (int player, int steps, bool resolveLanding = true);
+    bool step     (int player);
+    void action   (int player, GameTypes::ActionType actionType);
+    bool activate (int player, GameTypes::CardType cardType);
+    bool buy      (int player, int company);
+    bool upgrade  (int company, bool bonus);
+
+    // Statistics:
+    // * cardActivations returns how many cards of each type were activated from hands since the engine was created.
+    const QVector<int>& cardActivations () const;
+
+private:
+    void nextPlayer  ();
+    void passStart   (int player);
+    void resolveCell (int player);
+    void useCards    (int player);
+    void transferGold(int from, int to, int gold);
+    void upgradeRandomCompany (int player, int stars);
+
+    int  returns         (int player);
+    int  randomOpponent  (int player) const;
+    int  randomCompany   (int player) const;
+    int  topCompanyUpgradeLevel (int player) const;
+
+    // Nested movements (forward token after masterchef card etc.) are limited by MAX_MOVEMENT_DEPTH,
+    // so a map full of movement tokens can't loop forever.
+    static constexpr int MAX_MOVEMENT_DEPTH = 8;
+
+    GameState* m_state = nullptr;
+    Policy     m_policy;
+    int        m_movementDepth = 0;
+    QVector<int> m_cardActivations;
+};
+
+#endif // RULESENGINE_H
@@ -0,0 +1,179 @@
+#include "turnscheduler.h"
+
+#include <QtGlobal>
+#include <QStringList>
+
+#include <utility>
+
+TurnScheduler::TurnScheduler(QObject *parent)
+    : QObject (parent)
+{
+    // The only timer is connected once, it just wakes the queue up, when the waiting task should be called again.
+    m_timer.setSingleShot(true);
+    connect(&m_timer, &QTimer::timeout, this, &TurnScheduler::run);
+}
+
+void TurnScheduler::setMode(Mode mode)
+{
+    m_mode = mode;
+
+    if (m_mode == Mode::SYNCHRONOUS && m_timer.isActive())
+    {
+        m_timer.stop();
+        run();
+    }
+}
+
+TurnScheduler::Mode TurnScheduler::mode() const
+{
+    return m_mode;
+}
+
+void TurnScheduler::schedule(Phase phase, const Task &task, int interval)
+{
+    Entry entry;
+    entry.phase = phase;
+    entry.task = task;
+    entry.interval = interval;
+
+    // Nested phases go right after the running task, others wait for the end of the queue.
+    if (m_running)
+        m_queue.insert(m_insertAt++, entry);
+    else
+        m_queue.append(entry);
+
+    if (!m_running && !m_timer.isActive())
+        run();
+}
+
+void TurnScheduler::clear()
+{
+    m_timer.stop();
+
+    // The running task is removed by the loop itself, when it returns.
+    if (m_running)
+    {
+        m_queue.erase(m_queue.begin() + 1, m_queue.end());
+        m_dropRunning = true;
+    }
+    else
+        m_queue.clear();
+
+    m_insertAt = 1;
+}
+
+bool TurnScheduler::isIdle() const
+{
+    return m_queue.isEmpty();
+}
+
+TurnScheduler::Phase TurnScheduler::phase() const
+{
+    Q_ASSERT_X(!m_queue.isEmpty(), "TurnScheduler::phase", "There is no phase, when scheduler is idle.");
+
+    return m_queue.first().phase;
+}
+
+const TurnScheduler::PhaseStats &TurnScheduler::stats(Phase phase) const
+{
+    return m_stats[static_cast<int>(phase)];
+}
+
+void TurnScheduler::resetStats()
+{
+    for (int i = 0; i < PHASES_COUNT; ++i)
+        m_stats[i] = PhaseStats();
+}
+
+QString TurnScheduler::summary() const
+{
+    QStringList phases;
+    for (int i = 0; i < PHASES_COUNT; ++i)
+    {
+        const PhaseStats& s = m_stats[i];
+        double wall = s.count ? s.wallTime / 1e6 / s.count : 0.0;
+        double busy = s.count ? s.busyTime / 1e6 / s.count : 0.0;
+
+        phases.append(QString("%1: %2 x %3 ms (busy %4 ms)").arg(phaseToString(static_cast<Phase>(i))).arg(s.count)
+                      .arg(wall, 0, 'f', 3).arg(busy, 0, 'f', 3));
+    }
+
+    return phases.join("; ");
+}
+
+QString TurnScheduler::phaseToString(Phase phase)
+{
+    switch (phase)
+    {
+        case Phase::ROLL:         return "roll";
+        case Phase::MOVE:         return "move";
+        case Phase::RESOLVE_NODE: return "resolve node";
+        case Phase::RESOLVE_CARD: return "resolve card";
+        case Phase::END_TURN:     return "end turn";
+    }
+
+    return QString();
+}
+
+void TurnScheduler::run()
+{
+    if (m_running)
+        return;
+
+    m_running = true;
+    while (!m_queue.isEmpty())
+    {
+        // Task may schedule new ones, so the entry is not referenced while it runs.
+        // The task itself is moved out and back, so progress kept in its captures survives between the calls.
+        if (!m_queue.first().started)
+        {
+            m_queue.first().started = true;
+            m_queue.first().timer.start();
+        }
+
+        m_insertAt = 1;
+        Task task = std::move(m_queue.first().task);
+
+        QElapsedTimer busy;
+        busy.start();
+        bool complete = task();
+        qint64 busyTime = busy.nsecsElapsed();
+
+        // The task might clear the queue, then it is dropped without measurements.
+        if (m_dropRunning)
+        {
+            m_dropRunning = false;
+            m_queue.removeFirst();
+            continue;
+        }
+
+        Entry& entry = m_queue.first();
+        entry.busyTime += busyTime;
+        entry.task = std::move(task);
+
+        if (complete)
+        {
+            PhaseStats& s = m_stats[static_cast<int>(entry.phase)];
+            qint64 wallTime = entry.timer.nsecsElapsed();
+
+            ++s.count;
+            s.wallTime += wallTime;
+            s.busyTime += entry.busyTime;
+            s.maxWallTime = qMax(s.maxWallTime, wallTime);
+
+            m_queue.removeFirst();
+            continue;
+        }
+
+        // Unfinished task waits for the next tick of the animation.
+        if (m_mode == Mode::ANIMATED)
+        {
+            m_timer.start(entry.interval);
+            break;
+        }
+    }
+    m_running = false;
+
+    if (m_queue.isEmpty())
+        emit idle();
+}
@@ -0,0 +1,91 @@
+#ifndef TURNSCHEDULER_H
+#define TURNSCHEDULER_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QList>
+#include <QString>
+
+#include <functional>
+
+// TurnScheduler runs the turn as the pipeline of phases: roll, move, resolve node, resolve card and end turn.
+// Each phase is the task, that returns true, when it is complete, or false, when it should be called once more
+// (animated movement makes one step per call). Tasks are run one by one from the queue:
+// - in ANIMATED mode unfinished task is called again after its interval by the single timer of the scheduler;
+// - in SYNCHRONOUS mode unfinished task is called again immediately, so the whole queue is done before schedule returns.
+// Task may keep its progress in its own state (mutable lambda), the same object is called each time.
+// Tasks scheduled by the running task (movement after the forward token, for example) are put right after it,
+// in the order they were scheduled, so nested phases complete before the rest of the turn without any re-entrancy.
+// Scheduler also measures each phase: wall time from its start to completion and time spent inside its task.
+
+class TurnScheduler : public QObject
+{
+    Q_OBJECT
+
+public:
+    enum class Phase {ROLL, MOVE, RESOLVE_NODE, RESOLVE_CARD, END_TURN};
+    enum class Mode  {ANIMATED, SYNCHRONOUS};
+    static constexpr int PHASES_COUNT = 5;
+
+    using Task = std::function<bool()>;
+
+    // PhaseStats are the measurements of completed phases of one type, times are in nanoseconds.
+    struct PhaseStats
+    {
+        int    count = 0;
+        qint64 wallTime = 0;
+        qint64 busyTime = 0;
+        qint64 maxWallTime = 0;
+    };
+
+    explicit TurnScheduler(QObject* parent = nullptr);
+
+    // * setMode switches between animated and synchronous running, waiting task continues at once in synchronous mode;
+    // * schedule puts the task of specific phase into the queue and starts running, if scheduler is idle;
+    //   interval is the delay in milliseconds between calls of unfinished task in animated mode;
+    // * clear drops all the tasks, that are not complete yet;
+    // * isIdle returns true, if there are no tasks in the queue, phase returns the phase of the running or waiting task.
+    void setMode (Mode mode);
+    Mode mode () const;
+    void schedule (Phase phase, const Task& task, int interval = 0);
+    void clear ();
+    bool isIdle () const;
+    Phase phase () const;
+
+    // Measurements:
+    // * stats returns measurements of specific phase, resetStats forgets all of them;
+    // * summary returns the line with count and mean times of each phase;
+    // * phaseToString returns the name of the phase.
+    const PhaseStats& stats (Phase phase) const;
+    void resetStats ();
+    QString summary () const;
+    static QString phaseToString (Phase phase);
+
+signals:
+    void idle();
+
+private slots:
+    void run();
+
+private:
+    struct Entry
+    {
+        Phase phase;
+        Task  task;
+        int   interval = 0;
+        bool  started = false;
+        qint64 busyTime = 0;
+        QElapsedTimer timer;
+    };
+
+    QList<Entry> m_queue;
+    QTimer       m_timer;
+    Mode         m_mode = Mode::ANIMATED;
+    bool         m_running = false;
+    bool         m_dropRunning = false;
+    int          m_insertAt = 0;  // position for tasks scheduled by the running one
+    PhaseStats   m_stats[PHASES_COUNT];
+};
+
+#endif // TURNSCHEDULER_H
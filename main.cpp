@@ -1,15 +1,42 @@
 #include <QApplication>
-#include <QTime>
+#include <QCommandLineParser>
 
 #include "table.h"
+#include "ui/assetpack.h"
 
 int main (int argc, char* argv[])
 {
-    srand(QTime::currentTime().msec());
-
     QApplication app (argc, argv);    
 
+    // Games are random by default, the seed option allows to replay the game, which seed was written to the history.
+    QCommandLineParser parser;
+    QCommandLineOption seedOption   ("seed",   "Seed of the random generator, used to replay the same game.", "seed");
+    QCommandLineOption assetsOption ("assets", "Pack of images, made by monopoly-pack, images are read from files of its directory without it.", "file", AssetPack::DEFAULT_PATH);
+    QCommandLineOption mapOption    ("map",    "Map file saved by the table (*.tm), the default map of data directory if not set.", "file");
+    QCommandLineOption atOption     ("at",     "Catalog of action tokens, the one of data directory if not set.", "file");
+    QCommandLineOption otOption     ("ot",     "Catalog of ownership tokens, the one of data directory if not set.", "file");
+    QCommandLineOption cardsOption  ("cards",  "Catalog of cards, the one of data directory if not set.", "file");
+    parser.addHelpOption();
+    parser.addOptions({seedOption, assetsOption, mapOption, atOption, otOption, cardsOption});
+    parser.process(app);
+
+    // Artwork is mapped before the table creates tokens, cards and die.
+    AssetPack::instance().open(parser.value(assetsOption));
+
+    Table::Files files;
+    if (parser.isSet(mapOption))
+        files.map = parser.value(mapOption);
+    if (parser.isSet(atOption))
+        files.actionTokens = parser.value(atOption);
+    if (parser.isSet(otOption))
+        files.ownershipTokens = parser.value(otOption);
+    if (parser.isSet(cardsOption))
+        files.cards = parser.value(cardsOption);
+
     Table ui;
+    ui.setFiles(files);
+    if (parser.isSet(seedOption))
+        ui.setSeed(parser.value(seedOption).toULongLong());
     ui.show();
 
     return app.exec();
@@ -0,0 +1,63 @@
+# Table is the widget of the game together with its scene items: nodes, cards, units, hands and the views of ui folder.
+# It is shared by the application and the render benchmark, each of them adds its own main.cpp.
+
+INCLUDEPATH += $$PWD
+DEPENDPATH  += $$PWD
+
+SOURCES += \
+    $$PWD/cards/card.cpp \
+    $$PWD/cards/deck.cpp \
+    $$PWD/nodes/node.cpp \
+    $$PWD/nodes/nodeeditor.cpp \
+    $$PWD/nodes/tokens/actiontoken.cpp \
+    $$PWD/nodes/tokens/ownershiptoken.cpp \
+    $$PWD/nodes/tokens/token.cpp \
+    $$PWD/player/hand.cpp \
+    $$PWD/player/player.cpp \
+    $$PWD/table.cpp \
+    $$PWD/ui/die.cpp \
+    $$PWD/ui/dieview.cpp \
+    $$PWD/ui/boardlayer.cpp \
+    $$PWD/ui/imagecache.cpp \
+    $$PWD/ui/paintresources.cpp \
+    $$PWD/ui/textcache.cpp \
+    $$PWD/ui/spriteatlas.cpp \
+    $$PWD/ui/animationclock.cpp \
+    $$PWD/ui/assetpack.cpp \
+    $$PWD/ui/gameevents.cpp \
+    $$PWD/ui/historylabel.cpp \
+    $$PWD/ui/menu.cpp \
+    $$PWD/ui/repaintqueue.cpp \
+    $$PWD/ui/details.cpp \
+    $$PWD/ui/uielement.cpp \
+    $$PWD/ui/uielementfactory.cpp \
+    $$PWD/ui/view.cpp
+
+HEADERS += \
+    $$PWD/cards/card.h \
+    $$PWD/cards/deck.h \
+    $$PWD/nodes/node.h \
+    $$PWD/nodes/nodeeditor.h \
+    $$PWD/nodes/tokens/actiontoken.h \
+    $$PWD/nodes/tokens/ownershiptoken.h \
+    $$PWD/nodes/tokens/token.h \
+    $$PWD/player/hand.h \
+    $$PWD/player/player.h \
+    $$PWD/table.h \
+    $$PWD/ui/die.h \
+    $$PWD/ui/dieview.h \
+    $$PWD/ui/boardlayer.h \
+    $$PWD/ui/imagecache.h \
+    $$PWD/ui/paintresources.h \
+    $$PWD/ui/textcache.h \
+    $$PWD/ui/spriteatlas.h \
+    $$PWD/ui/animationclock.h \
+    $$PWD/ui/assetpack.h \
+    $$PWD/ui/gameevents.h \
+    $$PWD/ui/historylabel.h \
+    $$PWD/ui/menu.h \
+    $$PWD/ui/repaintqueue.h \
+    $$PWD/ui/details.h \
+    $$PWD/ui/uielement.h \
+    $$PWD/ui/uielementfactory.h \
+    $$PWD/ui/view.h
@@ -0,0 +1,39 @@
+TARGET = Monopoly
+QT += core gui widgets
+
+# The following define makes your compiler emit warnings if you use
+# any feature of Qt which has been marked as deprecated (the exact warnings
+# depend on your compiler). Please consult the documentation of the
+# deprecated API in order to know how to port your code away from it.
+DEFINES += QT_DEPRECATED_WARNINGS
+
+# You can also make your code fail to compile if you use deprecated APIs.
+# In order to do so, uncomment the following line.
+# You can also select to disable deprecated APIs only up to a certain version of Qt.
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+CONFIG += c++11 c++14 c++17
+
+# Game rules live in the core static library (see core/core.pro), application links against it.
+win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/core/release/ -lmonopolycore
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/core/debug/ -lmonopolycore
+else:unix: LIBS += -L$$OUT_PWD/core/ -lmonopolycore
+
+win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/core/release/libmonopolycore.a
+else:win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/core/debug/libmonopolycore.a
+else:win32:!win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/core/release/monopolycore.lib
+else:win32:!win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/core/debug/monopolycore.lib
+else:unix: PRE_TARGETDEPS += $$OUT_PWD/core/libmonopolycore.a
+
+INCLUDEPATH += $$PWD
+DEPENDPATH  += $$PWD/core
+
+SOURCES += \
+    main.cpp
+
+include(monopoly.pri)
+
+# LIBS += -LC:/Libraries/OpenCV-4.5.1/build2/install/x64/vc16/lib -lopencv_core451 -lopencv_videoio451 -lopencv_imgcodecs451 -lopencv_imgproc451
+
+# INCLUDEPATH += "C:/Libraries/OpenCV-4.5.1/build2/install/include"
+# DEPENDPATH += "c:/Libraries/OpenCV-4.5.1/build2/install/x64/vc16/bin"
@@ -1,8 +1,15 @@
 #include "node.h"
 
 #include <QPainter>
+#include <QStyleOptionGraphicsItem>
 #include <QDebug>
 
+#include "ui/imagecache.h"
+#include "ui/paintresources.h"
+#include "ui/textcache.h"
+#include "nodes/tokens/actiontoken.h"
+#include "nodes/tokens/ownershiptoken.h"
+
 Node::Node()
     : QGraphicsRectItem()
 {
@@ -34,12 +41,34 @@ QRectF Node::boundingRect() const
 
 void Node::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
 {
-    Q_UNUSED(option);
     Q_UNUSED(widget);
 
+    qreal lod = option ? option->levelOfDetailFromTransform(painter->worldTransform()) : 1.0;
+    draw(painter, detailFor(lod));
+}
+
+Node::Detail Node::detailFor(qreal levelOfDetail)
+{
+    if (levelOfDetail < FLAT_LOD)
+        return Detail::FLAT;
+
+    if (levelOfDetail < THUMBNAIL_LOD)
+        return Detail::THUMBNAIL;
+
+    return Detail::FULL;
+}
+
+void Node::draw(QPainter *painter, Node::Detail detail)
+{
+    if (detail == Detail::FLAT)
+    {
+        drawFlat(painter);
+        return;
+    }
+
     drawNode(painter);
     if (m_token)
-        drawToken(painter);
+        drawToken(painter, detail == Detail::FULL);
 }
 
 void Node::setActive(bool value)
@@ -84,12 +113,28 @@ void Node::drawNode(QPainter* painter)
     path.addRect(r);
     path.addRect(r.adjusted(7,7,-7,-7));
 
-    painter->setPen(QPen(QBrush(Qt::white), 2.f));
+    const PaintResources& resources = PaintResources::instance();
+    painter->setPen(resources.pen(PaintResources::Pen::NODE_BORDER));
     painter->drawPath(path);
-    painter->fillPath(path, QBrush(Qt::black));
+    painter->fillPath(path, resources.brush(PaintResources::Brush::NODE_FILL));
+}
+
+void Node::drawFlat(QPainter *painter)
+{
+    // Far out the frame, image and text are smaller than a few pixels, so only the kind of the node is shown.
+    const PaintResources& resources = PaintResources::instance();
+    ActionToken*    AT = dynamic_cast<ActionToken*>(m_token);
+    OwnershipToken* OT = dynamic_cast<OwnershipToken*>(m_token);
+
+    if (AT)
+        painter->fillRect(rect(), resources.actionBrush(AT->actionType()));
+    else if (OT)
+        painter->fillRect(rect(), resources.brush(PaintResources::Brush::NODE_COMPANY));
+    else
+        painter->fillRect(rect(), resources.brush(PaintResources::Brush::NODE_FILL));
 }
 
-void Node::drawToken(QPainter* painter)
+void Node::drawToken(QPainter* painter, bool withText)
 {
     // 1. Draw rectangle and fill it with a corresponding image.
     // qDebug() << "Node drawToken:: size of image is " << m_token->image().size();
@@ -97,18 +142,19 @@ void Node::drawToken(QPainter* painter)
 
     painter->drawRect(r);
     painter->fillRect(r, Qt::lightGray);
-    QImage img = m_token->image();
-    if (!img.isNull())
-        painter->drawImage(r, img);
+    ImageCache::instance().draw(painter, r, m_token->imagePath());
 
     // 2. Draw token name.
     //    if (!m_token->name().isNull())
     //        painter->drawText(QRectF(r.x(), r.y(), r.width(), r.height() / 4.0f), m_token->name(), QTextOption(Qt::AlignTop | Qt::AlignCenter));
 
-    // 3. Draw grid position string.
-    painter->drawText(QRectF(r.x() + 17, r.y() + 3.3f * r.height() / 4.0f, r.width(), r.height() / 4.0f),
-                      QString("(%1,%2)").arg(gridPosition().x()).arg(gridPosition().y()),
-                      QTextOption(Qt::AlignTop | Qt::AlignLeft));
+    // 3. Draw grid position string, if the node is close enough to read it.
+    if (!withText)
+        return;
+
+    TextCache::instance().draw(painter, QRectF(r.x() + 17, r.y() + 3.3f * r.height() / 4.0f, r.width(), r.height() / 4.0f),
+                               QString("(%1,%2)").arg(gridPosition().x()).arg(gridPosition().y()),
+                               PaintResources::instance().text(PaintResources::Text::TOP_LEFT));
 }
 
 void Node::clearToken()
@@ -14,6 +14,15 @@ class Node : public QGraphicsRectItem
 {
 
 public:
+    // Level of detail depends on the size of the node on the screen:
+    // - FLAT is the cell filled with the colour of its token type, used when the board is far out;
+    // - THUMBNAIL adds the frame of the node and the token image;
+    // - FULL adds the grid position text.
+    // FLAT_LOD and THUMBNAIL_LOD are the scales of the node on the screen (1.0 is its full size), where the next level begins.
+    enum class Detail {FLAT, THUMBNAIL, FULL};
+    static constexpr qreal FLAT_LOD = 0.25;
+    static constexpr qreal THUMBNAIL_LOD = 0.6;
+
     Node();
     Node(const QPoint& gridPosition);
     Node(const Node& other);
@@ -22,6 +31,11 @@ public:
     QRectF boundingRect() const override;
     void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = Q_NULLPTR) override;
 
+    // * detailFor returns the level of detail for the scale taken from the painter transform;
+    // * draw paints the node with specific level of detail (paint chooses it by itself).
+    static Detail detailFor (qreal levelOfDetail);
+    void draw (QPainter* painter, Detail detail);
+
     void setActive (bool value);
     bool isActive();
 
@@ -37,7 +51,8 @@ public:
 private:
     void setupShape (const QPoint& gridPosition, const QSize& size);
     void drawNode   (QPainter *painter);
-    void drawToken  (QPainter *painter);    
+    void drawToken  (QPainter *painter, bool withText);
+    void drawFlat   (QPainter *painter);
     void clearToken ();
 
     bool   m_isActive = false;
@@ -13,7 +13,7 @@
 #include <QGridLayout>
 
 #include "node.h"
-#include "helper/description.h"
+#include "core/description.h"
 
 class NodeEditor : public QDialog
 {
@@ -3,7 +3,7 @@
 #include <QDebug>
 
 ActionToken::ActionToken(ActionToken::ActionType type, const QString &name, const QString &description, const QString &imagePath)
-    : Token (name, description, "d:/monopoly/at/" + imagePath.trimmed())
+    : Token (name, description, "at/" + imagePath.trimmed())
 {
     setActionType(type);
 }
@@ -17,8 +17,19 @@ ActionToken::ActionToken(Description *atd)
 
     setName(atd->name());
     setDescription(atd->description());
-    setImage("d:/monopoly/at/" + atd->imagePath().trimmed());    
-    setActionType(stringToType(atd->type()));
+    setImage("at/" + atd->imagePath());
+
+    // Type has been parsed, when the catalog was loaded.
+    Q_ASSERT_X(atd->isKnownType(), "ActionToken::ActionToken", "The type of description is not one of the available action types");
+    setActionType(atd->actionType());
+}
+
+ActionToken::ActionToken(const ActionToken &prototype)
+    : Token (prototype)
+    , m_index (prototype.m_index)
+    , m_type (prototype.m_type)
+{
+
 }
 
 ActionToken::~ActionToken()
@@ -33,52 +44,17 @@ void ActionToken::setActionType(const ActionType &type)
 
 QString ActionToken::typeToString() const
 {
-    // Fill the lists with relevant action types and their string representations.
-    QList<ActionType> typesAT;
-    typesAT << ActionType::START << ActionType::PORTAL << ActionType::PRISON << ActionType::EXCHANGE << ActionType::MOVE_FORWARD << ActionType::MOVE_BACKWARD << ActionType::CARD_POSITIVE << ActionType::CARD_NEGATIVE;
-
-    QStringList typesSL;
-    typesSL << "start" << "portal" << "prison" << "exchange" << "move_forward" << "move_backward" << "card_positive" << "card_negative";
-
-    // Find index of parameter type in the list of available action types and return it.
-    int index = -1;
-    for (int i = 0; i < typesAT.count(); ++i)
-    {
-        if (m_type == typesAT.at(i))
-        {
-            index = i;
-            break;
-        }
-    }
-
-    return typesSL.at(index);
+    // String representations are shared with the rules core.
+    return GameTypes::actionTypeToString(m_type);
 }
 
 ActionToken::ActionType ActionToken::stringToType(const QString &name) const
 {
-    // 1. Fill types with string representations of enum values.
-    QStringList typesSL;
-    typesSL << "start" << "portal" << "prison" << "exchange" << "move_forward" << "move_backward" << "card_positive" << "card_negative";
-
-    QList<ActionType> typesAT;
-    typesAT << ActionType::START << ActionType::PORTAL << ActionType::PRISON << ActionType::EXCHANGE << ActionType::MOVE_FORWARD << ActionType::MOVE_BACKWARD << ActionType::CARD_POSITIVE << ActionType::CARD_NEGATIVE;
-
-    // 2. Seek the list for the item with the same string representation as parameter. Return its index in the list.
-    int index = -1;
-    for (int i = 0; i < typesSL.count(); ++i)
-    {
-        if (name.trimmed() == typesSL.at(i))
-        {
-            index = i;
-            break;
-        }
-    }
-
-    qDebug() << "TypesSL: " << typesSL.count() << ". TypesAT: " << typesAT.count() << ". Index: " << index;
-
-    // 3. Return the actual ActionType from the other list.
-    Q_ASSERT_X(index != -1, "ActionToken::stringToType", "The parameter \"name\" is not one of the available action types");
-    return typesAT.at(index);
+    bool ok = false;
+    ActionType type = GameTypes::stringToActionType(name, &ok);
+
+    Q_ASSERT_X(ok, "ActionToken::stringToType", "The parameter \"name\" is not one of the available action types");
+    return type;
 }
 
 const ActionToken::ActionType& ActionToken::actionType() const
@@ -2,15 +2,17 @@
 #define ACTIONTOKEN_H
 
 #include "token.h"
-#include "helper/description.h"
+#include "core/description.h"
+#include "core/gametypes.h"
 
 class ActionToken : public Token
 {
 public:
-    enum class ActionType {START, PORTAL, PRISON, EXCHANGE, MOVE_FORWARD, MOVE_BACKWARD, CARD_POSITIVE, CARD_NEGATIVE};
+    using ActionType = GameTypes::ActionType;
 
     ActionToken(ActionType actionType, const QString& name, const QString& description, const QString& imagePath);
     ActionToken(Description* atd);
+    ActionToken(const ActionToken& prototype);
     virtual ~ActionToken();
 
     void setActionType(const ActionType& actionType);    
@@ -4,11 +4,13 @@
 #include "player/player.h"
 
 OwnershipToken::OwnershipToken(const QString &name, const QString &description, const QString &imagePath)
-    : Token(name, description, "d:/monopoly/ot/" + imagePath.trimmed())
+    : Token(name, description, "ot/" + imagePath.trimmed())
+    , m_company (new Company)
 {
 }
 
 OwnershipToken::OwnershipToken(Description* otd)
+    : m_company (new Company)
 {
     if (otd->objectType() != Description::ObjectType::OWNERSHIP_TOKEN)
     {
@@ -18,17 +20,27 @@ OwnershipToken::OwnershipToken(Description* otd)
 
     setName(otd->name());
     setDescription(otd->description());
-    setImage("d:/monopoly/ot/" + otd->imagePath().trimmed());
-    setBuyingCost(otd->buyingCost().toInt());
-    setBasicIncome(otd->basicIncome().toInt());
-    setUpgradeLevel(otd->upgradeLevel().toInt());
-    setUpgradeCost(otd->arrayStringToIntegerVector(otd->upgradeCost()));
-    setUpgradeIncome(otd->arrayStringToIntegerVector(otd->upgradeIncome()));
+    setImage("ot/" + otd->imagePath());
+
+    // Values have been parsed, when the catalog was loaded, upgrade arrays are shared with the description.
+    setBuyingCost(otd->buyingCost());
+    setBasicIncome(otd->basicIncome());
+    setUpgradeLevel(otd->upgradeLevel());
+    setUpgradeCost(otd->upgradeCost());
+    setUpgradeIncome(otd->upgradeIncome());
 
     qDebug() << "image is null: " << image().isNull();
     qDebug() << "OT created using otd";
 }
 
+OwnershipToken::OwnershipToken(const OwnershipToken &prototype)
+    : Token (prototype)
+    , m_company (prototype.m_company)
+    , m_upgradeLevel (prototype.m_upgradeLevel)
+{
+
+}
+
 OwnershipToken::~OwnershipToken()
 {
 
@@ -37,13 +49,13 @@ OwnershipToken::~OwnershipToken()
 void OwnershipToken::setBuyingCost(int buyingCost)
 {
     if (buyingCost > 0)
-        m_buyingCost = buyingCost;
+        m_company->buyingCost = buyingCost;
 }
 
 void OwnershipToken::setBasicIncome(int basicIncome)
 {
     if (basicIncome > 0)
-        m_basicIncome = basicIncome;
+        m_company->basicIncome = basicIncome;
 }
 
 void OwnershipToken::setUpgradeLevel(int level)
@@ -54,12 +66,12 @@ void OwnershipToken::setUpgradeLevel(int level)
 
 void OwnershipToken::setUpgradeCost(const QVector<int>& upgradeCost)
 {
-    m_upgradeCost = upgradeCost;
+    m_company->upgradeCost = upgradeCost;
 }
 
 void OwnershipToken::setUpgradeIncome(const QVector<int>& upgradeIncome)
 {
-    m_upgradeIncome = upgradeIncome;
+    m_company->upgradeIncome = upgradeIncome;
 }
 
 bool OwnershipToken::hasOwner() const
@@ -79,12 +91,12 @@ const QRectF &OwnershipToken::thumbnailRegion() const
 
 int OwnershipToken::buyingCost() const
 {
-    return m_buyingCost;
+    return company().buyingCost;
 }
 
 int OwnershipToken::basicIncome() const
 {
-    return m_basicIncome;
+    return company().basicIncome;
 }
 
 int OwnershipToken::upgradeLevel() const
@@ -94,17 +106,23 @@ int OwnershipToken::upgradeLevel() const
 
 int OwnershipToken::cUpgradeCost() const
 {
-    return (m_upgradeLevel == 0) ? m_upgradeCost.at(0) : m_upgradeCost.at(m_upgradeLevel - 1);
+    const QVector<int>& upgradeCost = company().upgradeCost;
+    return (m_upgradeLevel == 0) ? upgradeCost.at(0) : upgradeCost.at(m_upgradeLevel - 1);
 }
 
 const QVector<int>& OwnershipToken::upgradeCost() const
 {
-    return m_upgradeCost;
+    return company().upgradeCost;
 }
 
 const QVector<int>& OwnershipToken::upgradeIncome() const
 {
-    return m_upgradeIncome;
+    return company().upgradeIncome;
+}
+
+const OwnershipToken::Company &OwnershipToken::company() const
+{
+    return *m_company.constData();
 }
 
 void OwnershipToken::activate()
@@ -134,10 +152,11 @@ void OwnershipToken::upgrade(bool bonus)
 
     if (!bonus)
     {
-        if (m_owner->hand()->gold() >= m_upgradeCost[m_upgradeLevel])
+        int cost = company().upgradeCost.at(m_upgradeLevel);
+        if (m_owner->hand()->gold() >= cost)
         {
             qDebug() << m_owner->name() << " is able to make this deal.";
-            m_owner->hand()->pay(m_upgradeCost[m_upgradeLevel]);
+            m_owner->hand()->pay(cost);
         }
         else
         {
@@ -155,10 +174,11 @@ void OwnershipToken::upgrade(bool bonus)
 int OwnershipToken::income()
 {
     int upgradeBonus = 0;
+    const Company& c = company();
     for (int i = 0; i < m_upgradeLevel; ++i)
-        upgradeBonus += m_upgradeIncome[i];
+        upgradeBonus += c.upgradeIncome.at(i);
 
-    return m_basicIncome + upgradeBonus;
+    return c.basicIncome + upgradeBonus;
 }
 
 
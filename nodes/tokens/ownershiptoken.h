@@ -2,7 +2,8 @@
 #define OWNERSHIPTOKEN_H
 
 #include "token.h"
-#include "helper/description.h"
+#include "core/description.h"
+#include "core/gamerules.h"
 
 class Player;
 
@@ -16,11 +17,15 @@ class Player;
 // OwnershipTokenDescription class will be used to store the data received from XML to use it later
 // to create instances using only indexes of elements stores in corresponding list.
 
+// Prices and incomes come from the catalog and are shared the same way as name and artwork (see Token),
+// only owner, upgrade level and thumbnail region belong to the token itself. Copy of the prototype has no owner.
+
 class OwnershipToken : public Token
 {
 public:
     OwnershipToken(const QString& name, const QString& description, const QString& imagePath);
     OwnershipToken(Description* otd);
+    OwnershipToken(const OwnershipToken& prototype);
     virtual ~OwnershipToken();
 
     void setBuyingCost    (int buyingCost);
@@ -52,17 +57,25 @@ public:
     friend QDataStream& operator>>(QDataStream &in,  OwnershipToken &t);
 
 private:
-    constexpr static int MAX_UPGRADE = 3;
+    constexpr static int MAX_UPGRADE = GameRules::MAX_UPGRADE;
 
     bool    m_hasOwner = false;
     Player* m_owner = nullptr;
     QRectF  m_thumbnailRegion;
 
-    int m_buyingCost;
-    int m_basicIncome;
+    struct Company : public QSharedData
+    {
+        int buyingCost = 0;
+        int basicIncome = 0;
+        QVector<int> upgradeCost;
+        QVector<int> upgradeIncome;
+    };
+
+    // company returns shared data for reading, so methods, that are not const, don't detach the token from its prototype.
+    const Company& company() const;
+
+    QSharedDataPointer<Company> m_company;
     int m_upgradeLevel = 0;
-    QVector<int> m_upgradeCost;
-    QVector<int> m_upgradeIncome;
 };
 
 #endif // OWNERSHIPTOKEN_H
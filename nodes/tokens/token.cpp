@@ -3,14 +3,18 @@
 #include <QFile>
 #include <QDebug>
 
+#include "ui/imagecache.h"
+
 Token::Token()
     : QGraphicsRectItem()
+    , m_data (new Data)
 {
 
 }
 
 Token::Token(const QString& name, const QString& description, const QString& imagePath)
     : QGraphicsRectItem ()
+    , m_data (new Data)
 {
     setName(name);
     setDescription(description);
@@ -19,10 +23,9 @@ Token::Token(const QString& name, const QString& description, const QString& ima
 
 Token::Token(const Token &other)
     : QGraphicsRectItem()
-{    
-    setName(other.name());
-    setDescription(other.description());
-    setImage(other.imagePath());
+    , m_data (other.m_data)
+{
+
 }
 
 Token::~Token()
@@ -37,45 +40,40 @@ QRectF Token::boundingRect() const
 
 void Token::setName(const QString &n)
 {
-    m_name = n;
+    m_data->name = n;
 }
 
 void Token::setDescription(const QString &d)
 {
-    m_description = d;
+    m_data->description = d;
 }
 
 void Token::setImage(const QString &path)
 {
-    m_imagePath = path;
-    qDebug() << "here" << m_imagePath;
+    m_data->imagePath = path;
 
-    m_image = QImage(path);
-    qDebug() << m_image.format();
-
-    qDebug() << m_image.size();
+    // Decoded images are shared by all tokens with the same artwork.
+    m_data->image = ImageCache::instance().source(path);
 }
 
 const QString &Token::name() const
 {
-    return m_name;
+    return m_data->name;
 }
 
 const QImage &Token::image() const
 {
-    return m_image;
+    return m_data->image;
 }
 
 const QString &Token::imagePath() const
 {
-    qDebug() << QString("Image path for token %1 is %2").arg(m_name).arg(m_imagePath);
-
-    return m_imagePath;
+    return m_data->imagePath;
 }
 
 const QString &Token::description() const
 {
-    return m_description;
+    return m_data->description;
 }
 
 QString Token::toString()
@@ -85,9 +83,7 @@ QString Token::toString()
 
 void Token::operator=(const Token &rhs)
 {
-    setName(rhs.name());
-    setDescription(rhs.description());
-    setImage(rhs.imagePath());
+    m_data = rhs.m_data;
 }
 
 void Token::activate()
@@ -2,6 +2,9 @@
 #define TOKEN_H
 
 #include <QGraphicsRectItem>
+#include <QSharedData>
+#include <QSharedDataPointer>
+#include <QImage>
 
 // Token are objects, that may be placed on any node of the scene.
 // This is base class for all types of tokens. They are:
@@ -39,6 +42,10 @@
 // [ot]****************************[ot]
 // [et][ot][ot][ot][c+][ot][ot][ot][pr]
 
+// Name, description and artwork of the token are kept in implicitly shared data. Tokens, that are copied from one prototype
+// (table keeps one per description), refer to the same data, so creating them doesn't copy strings or look for images.
+// Setters detach the token from its prototype, so editing one token doesn't change the others.
+
 class Token : public QGraphicsRectItem
 {
 public:
@@ -68,10 +75,15 @@ public:
     virtual void activate();
 
 private:
-    QString m_name;
-    QString m_description;
-    QString m_imagePath;
-    QImage  m_image;
+    struct Data : public QSharedData
+    {
+        QString name;
+        QString description;
+        QString imagePath;
+        QImage  image;
+    };
+
+    QSharedDataPointer<Data> m_data;
 };
 
 #endif // TOKEN_H
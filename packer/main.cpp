@@ -0,0 +1,35 @@
+#include <QGuiApplication>
+#include <QCommandLineParser>
+#include <QDebug>
+
+#include "ui/assetpack.h"
+
+// Packer builds the asset pack from the images of data directory, the application maps it at startup instead of opening each file.
+// It should be run again after artwork has been changed, the application doesn't compare the pack with the files.
+// Example: monopoly-pack --data data --output data/assets.pack
+
+int main (int argc, char* argv[])
+{
+    // Images are only decoded, no window is shown, so the offscreen platform is used unless another one is set.
+    if (qEnvironmentVariableIsEmpty("QT_QPA_PLATFORM"))
+        qputenv("QT_QPA_PLATFORM", "offscreen");
+
+    QGuiApplication app (argc, argv);
+    QGuiApplication::setApplicationName("monopoly-pack");
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Packs the images of tokens, cards and die into one file, that is mapped into memory by the game.");
+    parser.addHelpOption();
+
+    QCommandLineOption dataOption    ("data",    "Data directory with tokens, cards and die folders.", "directory", "data");
+    QCommandLineOption outputOption  ("output",  "File of the pack.", "file", AssetPack::DEFAULT_PATH);
+    QCommandLineOption encodedOption ("encoded", "Keep images encoded (smaller pack, images are decoded by the game on request).");
+
+    parser.addOptions({dataOption, outputOption, encodedOption});
+    parser.process(app);
+
+    if (!AssetPack::build(parser.value(dataOption), parser.value(outputOption), parser.isSet(encodedOption)))
+        return 1;
+
+    return 0;
+}
@@ -0,0 +1,21 @@
+TEMPLATE = app
+TARGET = monopoly-pack
+QT = core gui
+CONFIG += console c++11 c++14 c++17
+CONFIG -= app_bundle
+
+# Packer is the command-line tool, that packs the images of data directory into the asset pack (see ui/assetpack.h).
+# It decodes images with QtGui, but doesn't show anything, so it runs on machines without display.
+
+DEFINES += QT_DEPRECATED_WARNINGS
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+# Format of the pack is defined by the same class, that maps it in the application.
+INCLUDEPATH += $$PWD/..
+
+SOURCES += \
+    main.cpp \
+    ../ui/assetpack.cpp
+
+HEADERS += \
+    ../ui/assetpack.h
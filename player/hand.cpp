@@ -5,6 +5,9 @@
 #include <QDebug>
 
 #include "player.h"
+#include "ui/imagecache.h"
+#include "ui/paintresources.h"
+#include "ui/textcache.h"
 
 Hand::Hand(Player *player)
 {
@@ -48,140 +51,140 @@ void Hand::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWid
     if (m_side == Side::DEFAULT)
         return;
 
+    // Geometry is computed by the layout pass, paint only draws it.
+    updateLayout();
+
     // 0. Prepare drawing instruments.
-    QPen defaultPen = painter->pen();
-    QPen pathPen    = QPen(QBrush(Qt::white), 2);
-    QPen regionsPen = QPen(QBrush(Qt::white), 1);
-    QBrush defaultBrush   = painter->brush();
-    QBrush fillBrush    = QBrush(QColor("#eee"));
-    QBrush regionsBrush = QBrush(QColor("#111"));
-    QFont  basicFont = QFont("Comic Sans", 10);
-    QFont  cardsFont = QFont("Comic Sans", 7);
-
-    painter->setFont(basicFont);
+    const PaintResources& resources = PaintResources::instance();
+    const QPen& pathPen = resources.pen(PaintResources::Pen::HAND_PATH);
+    QBrush defaultBrush = painter->brush();
+    TextCache& texts = TextCache::instance();
+
+    painter->setFont(resources.font(PaintResources::Font::BASIC));
     painter->setRenderHint(QPainter::Antialiasing);
 
-    // 1. First, we should set the correct region for the hand and placement order for its objects.
-    // In this case, we use the *m_side* and *m_layout* enum variables to choose the right side and order.
-    // Having these, we can generate actual QPainterPath object using corresponding method and use it a a region to draw all other things.
+    // 1. Region of the hand itself.
+    painter->setPen(pathPen);
+    painter->drawPath(m_shape);
+    painter->fillPath(m_shape, resources.brush(PaintResources::Brush::HAND_FILL));
 
-    // qDebug() << "Region: " << m_shape;
+    // 2. Blocks for gold, name, tokens and cards.
+    painter->setPen(resources.pen(PaintResources::Pen::HAND_REGIONS));
+    painter->setBrush(resources.brush(PaintResources::Brush::HAND_REGIONS));
+        painter->drawRoundedRect(m_geometry.gold, 4, 4);
+        painter->drawRoundedRect(m_geometry.tokens, 4, 4);
+        painter->drawRoundedRect(m_geometry.cards, 4, 4);
+        painter->drawRoundedRect(m_geometry.name, 4, 4);
 
+    // 3. Gold and the name of the player are placed in the centers of their blocks.
     painter->setPen(pathPen);
-    painter->drawPath(m_shape);
-    painter->fillPath(m_shape, fillBrush);
-
-    // 2. As for objects' layout, that depends on the shape itself.
-    // If width greater than height, we should have horizontal placement of items.
-    // And vice versa: if height is greater than width, we must set items in vertical order.
-    // To do so, we could make two separate function for ordering and use some sort of enum to choose between them.
-    // Or make one function with a switch operator, but that will affect readability a little.
-
-    // Lets tear the shape into fragments, which will be later used to draw elements there.
-    // First, we'll need place to fit gold information. Pretend it is simple text, that should be placed in rectangle gR.
-    // We do nothing with triangle zones for now. As for width and height values, it depends.
-    // There should also be some spaces between rectangles, in which the objects will be drawn,
-    // Lets name it MARGIN in our example and set it to some value.
-    // The rest of drawing zones are initialized in the same way.
-
-    // Basic preparations
+        texts.draw(painter, m_geometry.gold, QString("Gold: %1").arg(m_gold), resources.text(PaintResources::Text::CENTER));
+    painter->setPen(m_player->color());
+        texts.draw(painter, m_geometry.name, m_player->name(), resources.text(PaintResources::Text::CENTER));
+
+    // 4. Thumbnails of tokens, that fit their block.
+    ImageCache& images = ImageCache::instance();
+    painter->setBrush(defaultBrush);
+    for (int i = 0; i < m_geometry.tokenSlots.count(); ++i)
+    {
+        const QRectF& slot = m_geometry.tokenSlots.rect(i);
+        OwnershipToken* token = m_ownershipTokens->at(i);
+
+        if (!token->image().isNull())
+        {
+            painter->fillRect(slot, Qt::lightGray);
+            images.draw(painter, slot, token->imagePath());
+            painter->drawRect(slot);
+        }
+    }
+
+    // 5. Thumbnails of cards: image in upper two thirds, name below.
+    painter->setFont(resources.font(PaintResources::Font::SMALL));
+    for (int j = 0; j < m_geometry.cardSlots.count(); ++j)
+    {
+        const QRectF& slot = m_geometry.cardSlots.rect(j);
+        Card* card = m_cards->at(j);
+
+        QRectF imageRect = QRectF(slot.x(), slot.y(), slot.width(), 2.0f * slot.height() / 3.0f);
+        QRectF nameRect  = QRectF(slot.x(), slot.y() + 2.0f * slot.height() / 3.0f, slot.width(), 1.0f * slot.height() / 3.0f);
+
+        painter->drawRect(slot);
+        if (!card->imageFrontFG().isNull())
+            images.draw(painter, imageRect, card->foregroundPath());
+
+        texts.draw(painter, nameRect, card->name(), resources.text(PaintResources::Text::CENTER));
+    }
+}
+
+void Hand::invalidateLayout()
+{
+    m_layoutDirty = true;
+}
+
+void Hand::updateLayout()
+{
+    if (!m_layoutDirty)
+        return;
+
+    m_layoutDirty = false;
+    m_geometry = Geometry();
+    if (m_side == Side::DEFAULT)
+        return;
+
+    // The shape is torn into blocks, that follow each other from the top: gold, name, tokens and cards.
+    // Triangle zones at the ends of the shape are left empty, MARGIN_RECTS separate the blocks.
     int MARGIN_RECTS = 10;
     int MARGIN_TRIANGLE = 50;
     int MARGIN_BORDERS = 3;
+    int MARGIN_TOKENS = 5;
 
     QRectF  bR = boundingRect();
-    QPointF tL = boundingRect().topLeft();
+    QPointF tL = bR.topLeft();
 
     // Gold information block.
-    QRectF  gR = QRectF(tL.x() + MARGIN_BORDERS, tL.y() + MARGIN_TRIANGLE, bR.width() - MARGIN_BORDERS*2, MARGIN_TRIANGLE);
+    QRectF& gR = m_geometry.gold;
+    gR = QRectF(tL.x() + MARGIN_BORDERS, tL.y() + MARGIN_TRIANGLE, bR.width() - MARGIN_BORDERS*2, MARGIN_TRIANGLE);
     QPointF gBL = gR.bottomLeft() - QPointF(MARGIN_BORDERS, 0);
 
-    QRectF nR = QRectF(gBL.x() + MARGIN_BORDERS, gBL.y() + MARGIN_RECTS, bR.width() - MARGIN_BORDERS*2, 1*bR.height()/7 - MARGIN_TRIANGLE*2);
+    // Player name block.
+    QRectF& nR = m_geometry.name;
+    nR = QRectF(gBL.x() + MARGIN_BORDERS, gBL.y() + MARGIN_RECTS, bR.width() - MARGIN_BORDERS*2, 1*bR.height()/7 - MARGIN_TRIANGLE*2);
     QPointF nBL = nR.bottomLeft() - QPointF(MARGIN_BORDERS, 0);
 
     // Collected tokens block.
-    QRectF  tR = QRectF(nBL.x() + MARGIN_BORDERS, nBL.y() + MARGIN_RECTS, bR.width() - MARGIN_BORDERS*2, 5*bR.height()/11 - MARGIN_TRIANGLE*2);
+    QRectF& tR = m_geometry.tokens;
+    tR = QRectF(nBL.x() + MARGIN_BORDERS, nBL.y() + MARGIN_RECTS, bR.width() - MARGIN_BORDERS*2, 5*bR.height()/11 - MARGIN_TRIANGLE*2);
     QPointF tBL = tR.bottomLeft() - QPointF(MARGIN_BORDERS, 0);
 
     // Collected cards block.
-    QRectF cR = QRectF(tBL.x() + MARGIN_BORDERS, tBL.y() + MARGIN_RECTS, bR.width() - MARGIN_BORDERS*2,  4*bR.height()/9 - MARGIN_TRIANGLE*2 + MARGIN_RECTS*3);
-
-    // qDebug() << "G: " << m_gold;
-
-    // Draw rectangles
-    painter->setPen(regionsPen);
-    painter->setBrush(regionsBrush);
-        painter->drawRoundedRect(gR, 4, 4);    
-        painter->drawRoundedRect(tR, 4, 4);
-        painter->drawRoundedRect(cR, 4, 4);
-        painter->drawRoundedRect(nR, 4, 4);
-
-    // Draw actual objects
-    // 1. Rectangle gR is meant to be storage for gold information.
-    // Lets make the string using the relevant value and place it in its center.
-    painter->setPen(pathPen);
-        painter->drawText(gR, QString("Gold: %1").arg(m_gold), QTextOption(Qt::AlignCenter));
-    painter->setPen(m_player->color());
-        painter->drawText(nR, m_player->name(), QTextOption(Qt::AlignCenter));
-
-    // 2. Rectangle tR should contain all tokens collected by the player.
-    // Since they are stored in a list, we check its existence, walk through each OT and call its paint event.
-    // The problem: why they don't recognize negative scene coordinates? Check!
-    painter->setBrush(defaultBrush);
-    if (m_ownershipTokens)
+    QRectF& cR = m_geometry.cards;
+    cR = QRectF(tBL.x() + MARGIN_BORDERS, tBL.y() + MARGIN_RECTS, bR.width() - MARGIN_BORDERS*2,  4*bR.height()/9 - MARGIN_TRIANGLE*2 + MARGIN_RECTS*3);
+
+    // Token thumbnails are squares in one column. Only those, that fit the block, are placed,
+    // so hidden ones can't be clicked through the cards block.
+    int size = tR.width() - MARGIN_TOKENS * 2;
+    int spacing = tR.width() - MARGIN_TOKENS * 2 + 5;
+    m_geometry.tokenSlots.reset(QPointF(tR.x() + MARGIN_TOKENS, tR.y() + MARGIN_TOKENS), QSizeF(size, size), spacing);
+    for (int i = 0; i < m_ownershipTokens->count(); ++i)
     {
-        for (int i = 0; i < m_ownershipTokens->count(); ++i)
-        {
-            // Set the rectangle for each OT and draw it.
-            OwnershipToken* token = m_ownershipTokens->at(i);
-
-            int MARGIN_TOKENS = 5;
-            int size = tR.width() - MARGIN_TOKENS * 2;
-            int spacing = tR.width() - MARGIN_TOKENS * 2 + 5;
-
-            // Calculate rectangle for token thumbnail, that should be placed somewhere in the overall tokens rectangle.
-            QRectF tR_tt = QRectF (tR.x() + MARGIN_TOKENS, tR.y() + MARGIN_TOKENS + spacing * i, size, size);
-            token->setThumbnailRegion(tR_tt);
-
-            bool tokenHasImage  = !(token->image().isNull());
-            bool tokenIsVisible = (tR_tt.bottomRight().y() < tR.bottomRight().y());
-
-            if (tokenIsVisible && tokenHasImage)
-            {
-                painter->fillRect(tR_tt, Qt::lightGray);
-                painter->drawImage(tR_tt, token->image());
-                painter->drawRect(tR_tt);
-            }
-        }
+        QRectF slot = m_geometry.tokenSlots.next();
+        if (slot.bottom() >= tR.bottom())
+            break;
+
+        m_geometry.tokenSlots.append(slot);
+        m_ownershipTokens->at(i)->setThumbnailRegion(slot);
     }
 
-    painter->setFont(cardsFont);
-    if (m_cards)
+    // Card thumbnails are 2:3 rectangles in one column.
+    int width = cR.width() - MARGIN_TOKENS * 2;
+    int height = 1.5f * width;
+    spacing = cR.width() - MARGIN_TOKENS * 2 + 5;
+    m_geometry.cardSlots.reset(QPointF(cR.x() + MARGIN_TOKENS, cR.y() + MARGIN_TOKENS), QSizeF(width, height), spacing);
+    for (int j = 0; j < m_cards->count(); ++j)
     {
-        for (int j = 0; j < m_cards->count(); ++j)
-        {
-            Card* card = m_cards->at(j);
-
-            int MARGIN_TOKENS = 5;
-            int width = cR.width() - MARGIN_TOKENS * 2;
-            int height = 1.5f * width;
-            int spacing = cR.width() - MARGIN_TOKENS * 2 + 5;
-
-            QRectF cR_ct = QRectF(cR.x() + MARGIN_TOKENS, cR.y() + MARGIN_TOKENS + spacing * j, width, height);
-            QRectF cR_ct_image = QRectF(cR_ct.x(), cR_ct.y(), cR_ct.width(), 2.0f * cR_ct.height() / 3.0f);
-            QRectF cR_ct_name  = QRectF(cR_ct.x(), cR_ct.y() + 2.0f * cR_ct.height() / 3.0f, cR_ct.width(), 1.0f * cR_ct.height() / 3.0f);
-            card->setThumbnailRegion(cR_ct);
-
-            painter->drawRect(cR_ct);
-            qDebug() << "Card has front image: " << !card->imageFrontFG().isNull();
-            if (!card->imageFrontFG().isNull())
-                painter->drawImage(cR_ct_image, card->imageFrontFG());
-
-            if (painter == nullptr)
-                qDebug() << "no painter!";
-
-            painter->drawText(cR_ct_name, card->name(), QTextOption(Qt::AlignCenter));
-        }
+        QRectF slot = m_geometry.cardSlots.next();
+        m_geometry.cardSlots.append(slot);
+        m_cards->at(j)->setThumbnailRegion(slot);
     }
 }
 
@@ -189,7 +192,10 @@ void Hand::addToken(OwnershipToken *token)
 {
     Q_ASSERT_X(m_ownershipTokens != nullptr, "Hand::addToken(OwnershipToken)", "Ownership tokens list has not been initialized yet.");
     if (!m_ownershipTokens->contains(token))
+    {
         m_ownershipTokens->append(token);
+        invalidateLayout();
+    }
 }
 
 void Hand::setSide(QPair<Side, QPainterPath>* side)
@@ -214,60 +220,51 @@ void Hand::setSide(QPair<Side, QPainterPath>* side)
     }
 
     m_shape = side->second;
+    invalidateLayout();
 }
 
 void Hand::removeToken(Token *token)
 {
     OwnershipToken* ot = dynamic_cast<OwnershipToken*>(token);
-    if (ot && m_ownershipTokens->contains(ot))
-        m_ownershipTokens->removeOne(ot);
+    if (ot && m_ownershipTokens->removeOne(ot))
+        invalidateLayout();
 }
 
 Token *Hand::takeTokenAtPosition(const QPointF &pixelPosition)
 {
-    Token* token = nullptr;
+    updateLayout();
 
-    for (int i = 0; i < m_ownershipTokens->count(); ++i)
-    {
-        OwnershipToken* ot = m_ownershipTokens->at(i);
-        if (ot->thumbnailRegion().contains(pixelPosition))
-        {
-            token = ot;
-            break;
-        }
-    }
-
-    return token;
+    int index = m_geometry.tokenSlots.indexAt(pixelPosition);
+    return (index >= 0) ? m_ownershipTokens->at(index) : nullptr;
 }
 
 Card *Hand::takeCardAtPosition(const QPointF &pixelPosition)
 {
-    Card* card = nullptr;
+    updateLayout();
 
-    for (int i = 0; i < m_cards->count(); ++i)
-    {
-        Card* toCheck = m_cards->at(i);
-        if (toCheck->thumbnailRegion().contains(pixelPosition))
-        {
-            card = toCheck;
-            break;
-        }
-    }
-
-    return card;
+    int index = m_geometry.cardSlots.indexAt(pixelPosition);
+    return (index >= 0) ? m_cards->at(index) : nullptr;
 }
 
 void Hand::addCard(Card *card)
 {
     Q_ASSERT_X(m_cards != nullptr, "Hand::addCard", "Cards list has not been initialized yet.");
     if (!m_cards->contains(card))
+    {
         m_cards->append(card);
+        invalidateLayout();
+    }
 }
 
 void Hand::removeCard(Card *card)
 {
-    if (m_cards->contains(card))
-        m_cards->removeOne(card);
+    if (m_cards->removeOne(card))
+        invalidateLayout();
+}
+
+bool Hand::hasCard(Card *card) const
+{
+    return m_cards->contains(card);
 }
 
 const int &Hand::gold() const
@@ -343,11 +340,11 @@ void Hand::setIncomeStopped(bool value)
     m_isIncomeStopped = value;
 }
 
-OwnershipToken *Hand::randomCompany()
+OwnershipToken *Hand::randomCompany(GameRandom &random)
 {
     if (m_ownershipTokens->count() > 0)
     {
-        int index = rand() % m_ownershipTokens->count();
+        int index = random.index(GameRandom::Stream::CARDS, m_ownershipTokens->count());
         return m_ownershipTokens->at(index);
     }
     else
@@ -371,7 +368,7 @@ int Hand::topCompanyUpgradeLevel()
     return top;
 }
 
-void Hand::upgradeRandomCompany(int stars)
+void Hand::upgradeRandomCompany(int stars, GameRandom &random)
 {
     Q_ASSERT_X(stars >= 1 && stars <= 3, "Hand::upgradeCompany", "Stars parameter should be in range [1;3].");
 
@@ -381,7 +378,7 @@ void Hand::upgradeRandomCompany(int stars)
         return;
     }
 
-    int index = rand() % m_ownershipTokens->count();
+    int index = random.index(GameRandom::Stream::CARDS, m_ownershipTokens->count());
 
     OwnershipToken* OT = m_ownershipTokens->at(index);
     for (int i = 0; i < stars; ++i)
@@ -408,6 +405,7 @@ void Hand::clearActionTokens()
             delete m_actionTokens->at(i);
 
         m_actionTokens->clear();
+        invalidateLayout();
 
         qDebug() << "Hands :: AT list cleared";
         qDebug() << "AT count: " << m_actionTokens->count();
@@ -424,6 +422,7 @@ void Hand::clearOwnershipTokens()
             m_ownershipTokens->removeAt(i);
 
         m_ownershipTokens->clear();
+        invalidateLayout();
 
         qDebug() << "Hands :: OT list cleared";
         qDebug() << "OT count: " << m_ownershipTokens->count();
@@ -438,7 +437,51 @@ void Hand::clearCards()
             m_cards->removeAt(i);
 
         m_cards->clear();
+        invalidateLayout();
 
         qDebug() << "Hands :: Cards list cleared";
     }
 }
+
+// ************************************************** SLOTS
+
+void Hand::Slots::reset(const QPointF &origin, const QSizeF &size, qreal spacing)
+{
+    Q_ASSERT_X(spacing > 0, "Hand::Slots::reset", "Spacing of thumbnails should be greater than zero.");
+
+    m_origin = origin;
+    m_size = size;
+    m_spacing = spacing;
+    m_rects.clear();
+}
+
+QRectF Hand::Slots::next() const
+{
+    return QRectF(m_origin + QPointF(0, m_spacing * m_rects.count()), m_size);
+}
+
+void Hand::Slots::append(const QRectF &rect)
+{
+    m_rects.append(rect);
+}
+
+int Hand::Slots::indexAt(const QPointF &position) const
+{
+    // Row under the position is the only candidate, it is checked to skip the gaps between thumbnails.
+    qreal row = (position.y() - m_origin.y()) / m_spacing;
+    if (row < 0 || row >= m_rects.count())
+        return -1;
+
+    int index = int(row);
+    return m_rects.at(index).contains(position) ? index : -1;
+}
+
+int Hand::Slots::count() const
+{
+    return m_rects.count();
+}
+
+const QRectF &Hand::Slots::rect(int index) const
+{
+    return m_rects.at(index);
+}
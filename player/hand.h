@@ -3,10 +3,12 @@
 
 #include <QGraphicsRectItem>
 #include <QList>
+#include <QVector>
 
 #include "nodes/tokens/actiontoken.h"
 #include "nodes/tokens/ownershiptoken.h"
 #include "cards/card.h"
+#include "core/gamerandom.h"
 
 // Remark: in case of circular references (for example, a -> b -> c -> a,
 // where -> means left class includes right class) and guard clauses use
@@ -17,6 +19,13 @@
 // - the list of tokens (methods to add new token to one of the lists and to remove it from there),
 // - the list of bonus cards,
 // - the rendering subsystem, that uses 1 of the 4 positions (on the top, bottom, left or right side of the scene: (enum?): TOP, RIGHT, BOTTOM, LEFT)
+//
+// Rendering is split into two passes:
+// - updateLayout computes the blocks of the hand and the slots of token and card thumbnails, it runs only after
+//   the contents or the side of the hand have been changed (invalidateLayout marks that);
+// - paint draws the computed geometry and doesn't change anything.
+// Thumbnails of one kind lie in one column with constant spacing, so Slots finds the one under the cursor
+// by its row number instead of checking all of them.
 
 // Also:
 // The trading subsystem, that activates when player hits exchange token.
@@ -50,6 +59,28 @@ public:
     // Interaction with cards
     void addCard (Card* card);
     void removeCard (Card* card);
+    bool hasCard (Card* card) const;
+
+    // Slots is the column of thumbnails with constant spacing, used as the spatial index for hit tests:
+    // * reset starts the new column at origin with specific size of thumbnails and distance between their tops;
+    // * next returns the rect for the next thumbnail, append places it;
+    // * indexAt returns the index of the thumbnail under position or -1.
+    class Slots
+    {
+    public:
+        void   reset   (const QPointF& origin, const QSizeF& size, qreal spacing);
+        QRectF next    () const;
+        void   append  (const QRectF& rect);
+        int    indexAt (const QPointF& position) const;
+        int    count   () const;
+        const QRectF& rect (int index) const;
+
+    private:
+        QPointF m_origin;
+        QSizeF  m_size;
+        qreal   m_spacing = 1;
+        QVector<QRectF> m_rects;
+    };
 
     // Interaction with gold
     const int& gold() const;
@@ -64,8 +95,8 @@ public:
     void setIncomeDoubled(bool value);
     void setIncomeStopped(bool value);
 
-    OwnershipToken* randomCompany();
-    void upgradeRandomCompany(int stars);
+    OwnershipToken* randomCompany(GameRandom& random);
+    void upgradeRandomCompany(int stars, GameRandom& random);
     int  topCompanyUpgradeLevel();
 
     void clear();
@@ -76,11 +107,24 @@ public:
     void clearOwnershipTokens();
     void clearCards();
 
+    // Layout
+    void invalidateLayout();
+    void updateLayout();
+
     // UI
     Side m_side = Side::DEFAULT;
     QPainterPath m_shape;
     Layout m_layout;
 
+    // Geometry computed by the last layout pass: blocks of gold, name, tokens and cards, thumbnails of tokens and cards.
+    struct Geometry
+    {
+        QRectF gold, name, tokens, cards;
+        Slots  tokenSlots, cardSlots;
+    };
+    Geometry m_geometry;
+    bool     m_layoutDirty = true;
+
     // Hand knows his body :)
     Player* m_player = nullptr;
 
@@ -4,6 +4,8 @@
 #include <QFileInfo>
 #include <QDebug>
 
+#include "ui/imagecache.h"
+
 Player::Player(const QPoint& gridPosition, const QString& name, const QColor& color, const QString &imagePath)
 {
     setGridPosition(gridPosition);
@@ -19,7 +21,7 @@ Player::Player(const QPoint& gridPosition, const QString& name, const QColor& co
 
 Player::~Player()
 {
-
+    AnimationClock::instance().stop(this);
 }
 
 QRectF Player::boundingRect() const
@@ -32,18 +34,44 @@ void Player::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QW
     Q_UNUSED(option);
     Q_UNUSED(widget);
 
-    // 1. Prepare instuments for drawing
-    QPen pen = QPen(QBrush(m_color.darker(40)), 3);
-    QBrush brush = QBrush(m_color);
-    painter->setRenderHint(QPainter::Antialiasing);
+    // Sprite depends on the scale of the view too, so zoomed units are not blurred.
+    qreal scale = ImageCache::ratioFor(painter);
+    if (m_spriteDirty || !qFuzzyCompare(m_spriteScale, scale) || !SpriteAtlas::instance().isValid(m_sprite))
+        updateSprite(scale);
+
+    if (SpriteAtlas::instance().isValid(m_sprite))
+        SpriteAtlas::instance().draw(painter, rect(), m_sprite);
+    else
+        drawShape(painter, rect());
+}
 
-    // 2. Calculate path.
-    QPainterPath path = pathForCurrentShape();
+void Player::drawShape(QPainter *painter, const QRectF &rect) const
+{
+    painter->setRenderHint(QPainter::Antialiasing);
 
-    // 3. Draw paths and fill them using selected pens and brushes.
-    painter->setPen(pen);
+    QPainterPath path = pathForShape(rect);
+    painter->setPen(m_pen);
     painter->drawPath(path);
-    painter->fillPath(path, brush);
+    painter->fillPath(path, m_brush);
+}
+
+void Player::updateSprite(qreal scale)
+{
+    // Unit is rendered at the origin, the sprite is then placed to the rect of the node it stands on.
+    QRectF local (QPointF(0, 0), rect().size());
+    m_sprite = SpriteAtlas::instance().add(spriteKey(scale), local.size(), scale, [this, local](QPainter* painter)
+    {
+        drawShape(painter, local);
+    });
+
+    m_spriteScale = scale;
+    m_spriteDirty = false;
+}
+
+QString Player::spriteKey(qreal scale) const
+{
+    return QString("unit|%1|%2|%3x%4@%5").arg(static_cast<int>(m_shape)).arg(m_color.rgba())
+                                         .arg(rect().width()).arg(rect().height()).arg(scale);
 }
 
 const QPoint &Player::gridPosition()
@@ -117,35 +145,35 @@ void Player::circle()
     ++m_rounds;
 }
 
-QPainterPath Player::pathForCurrentShape()
+QPainterPath Player::pathForShape(const QRectF& rect) const
 {
     QPainterPath shape;
 
     switch (m_shape)
     {
     case Shape::SQUARE:
-        shape.addRect(rect().adjusted(30,30,-30,-30));
+        shape.addRect(rect.adjusted(30,30,-30,-30));
         break;
 
     case Shape::CIRCLE:
-        shape.addEllipse(rect().adjusted(30,30,-30,-30));
+        shape.addEllipse(rect.adjusted(30,30,-30,-30));
         break;
 
     case Shape::ROMB:
-        int margin = 25;                                                                         // shift from the border
+        int margin = 25;                                                                 // shift from the border
 
-        shape.moveTo(rect().x() + rect().width() / 2.0f, rect().y() + margin);                   // center of upper border line
-        shape.lineTo(rect().x() + rect().width() - margin, rect().y() + rect().height() / 2.0f); // center of right border line
-        shape.lineTo(rect().x() + rect().width() / 2.0f, rect().y() + rect().height() - margin); // center of lower border line
-        shape.lineTo(rect().x() + margin, rect().y() + rect().height() / 2.0f);                  // center of left  border line
-        shape.lineTo(rect().x() + rect().width() / 2.0f, rect().y() + margin);                   // center of upper border line
+        shape.moveTo(rect.x() + rect.width() / 2.0f, rect.y() + margin);                 // center of upper border line
+        shape.lineTo(rect.x() + rect.width() - margin, rect.y() + rect.height() / 2.0f); // center of right border line
+        shape.lineTo(rect.x() + rect.width() / 2.0f, rect.y() + rect.height() - margin); // center of lower border line
+        shape.lineTo(rect.x() + margin, rect.y() + rect.height() / 2.0f);                // center of left  border line
+        shape.lineTo(rect.x() + rect.width() / 2.0f, rect.y() + margin);                 // center of upper border line
 
 
         break;
     }
 
     if (shape.isEmpty())
-        shape.addRect(rect()); // default case
+        shape.addRect(rect); // default case
 
     return shape;
 }
@@ -162,9 +190,10 @@ void Player::setDirection(const Player::Direction &direction)
 
 void Player::setImage(const QString &imagePath)
 {
+    // Image is decoded once and shared through the image cache, it is scaled only when drawn.
     if (QFileInfo::exists(imagePath))
     {
-        m_image = QImage(imagePath).scaled(rect().width(), rect().height());
+        m_image = ImageCache::instance().source(imagePath);
         update();
     }
 }
@@ -172,18 +201,23 @@ void Player::setImage(const QString &imagePath)
 void Player::setShape(const Player::Shape &shape)
 {
     m_shape = shape;
+    m_spriteDirty = true;
     update();
 }
 
 void Player::setColor(const QColor &color)
 {
     m_color = color;
+    m_pen = QPen(QBrush(m_color.darker(40)), 3);
+    m_brush = QBrush(m_color);
+    m_spriteDirty = true;
     update();
 }
 
 void Player::setSize(const QSize &size)
 {
     m_size = size;
+    m_spriteDirty = true;
 }
 
 void Player::setName(const QString &name)
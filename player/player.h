@@ -4,12 +4,20 @@
 #include <QGraphicsRectItem>
 
 #include "hand.h"
+#include "core/gametypes.h"
+#include "ui/spriteatlas.h"
+#include "ui/animationclock.h"
+
+// Player is the unit on the board together with the hand of its owner.
+// Unit is drawn from the sprite atlas: its shape, colour and size are rendered into the sprite once,
+// paint only blits it. Sprite is made again only after setShape, setColor or setSize (or when the atlas has been cleared).
+// Rect of the unit is always the rect of its node, while it glides between nodes, item position is the offset from there.
 
 class Player : public QGraphicsRectItem
 {
 public:
     enum class Shape {SQUARE, ROMB, CIRCLE};
-    enum class Direction  {LEFT, UP, RIGHT, DOWN, LEFT_UP, LEFT_DOWN, RIGHT_UP, RIGHT_DOWN, NO_MOVE};
+    using Direction = GameTypes::Direction;
 
     explicit Player(const QPoint& gridPosition, const QString& name, const QColor& color, const QString& imagePath);
     ~Player();
@@ -42,7 +50,10 @@ public:
     void  circle();
 
 private:    
-    QPainterPath pathForCurrentShape();
+    QPainterPath pathForShape (const QRectF& rect) const;
+    void drawShape    (QPainter* painter, const QRectF& rect) const;
+    void updateSprite (qreal scale);
+    QString spriteKey (qreal scale) const;
 
 
     QPoint  m_gridPosition;
@@ -50,10 +61,17 @@ private:
     Hand* m_hand = nullptr;
 
     // Basic things: position, shape and name.
-    Shape   m_shape;
+    Shape   m_shape = Shape::SQUARE;
     QSize   m_size;
     QColor  m_color;
+    QPen    m_pen;   // made from m_color by setColor, so paint doesn't create instruments
+    QBrush  m_brush;
     QImage  m_image;
+
+    // Sprite of the unit in the atlas and the scale it has been rendered at.
+    SpriteAtlas::Sprite m_sprite;
+    qreal m_spriteScale = 0;
+    bool  m_spriteDirty = true;
     QString m_name;
 
     // Various statistics variables.
@@ -0,0 +1,122 @@
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QElapsedTimer>
+#include <QDebug>
+#include <QFile>
+#include <QTextStream>
+
+#include "core/catalogloader.h"
+#include "core/gamestate.h"
+#include "simulator/simulation.h"
+
+// Simulator plays many games on the map headlessly and writes their statistics, so rules and catalogs can be balanced.
+// Example: monopoly-sim data/maps/not_round.tm --games 100000 --players 4 --seed 42 --output results.csv
+
+int main (int argc, char* argv[])
+{
+    QCoreApplication app (argc, argv);
+    QCoreApplication::setApplicationName("monopoly-sim");
+
+    Simulation::Settings defaults;
+
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Plays many games of monopoly on the map and writes win rates, game length, gold curves and card activations.");
+    parser.addHelpOption();
+    parser.addPositionalArgument("map", "Map file saved by the table (*.tm).");
+
+    QCommandLineOption atOption      ("at",      "Catalog of action tokens.",    "file", "data/tokens/at/at.xml");
+    QCommandLineOption otOption      ("ot",      "Catalog of ownership tokens.", "file", "data/tokens/ot/ot.xml");
+    QCommandLineOption cardsOption   ("cards",   "Catalog of cards.",            "file", "data/cards/cards.xml");
+    QCommandLineOption gamesOption   ("games",   "Count of games to play.",      "count", QString::number(defaults.games));
+    QCommandLineOption threadsOption ("threads", "Count of threads, 0 to use all the cores.", "count", QString::number(defaults.threads));
+    QCommandLineOption playersOption ("players", "Count of players in each game.", "count", QString::number(defaults.players));
+    QCommandLineOption goldOption    ("gold",    "Start gold of each player.",   "gold",  QString::number(defaults.startGold));
+    QCommandLineOption turnsOption   ("turns",   "Maximum count of turns in each game.", "count", QString::number(defaults.maxTurns));
+    QCommandLineOption circlesOption ("circles", "Count of circles, that finishes the game.", "count", QString::number(defaults.circlesToFinish));
+    QCommandLineOption copiesOption  ("copies",  "Count of copies of each card in the decks.", "count", QString::number(defaults.deckCopies));
+    QCommandLineOption seedOption    ("seed",    "Seed of the first game, next games use the following seeds.", "seed", QString::number(defaults.seed));
+    QCommandLineOption outputOption  ("output",  "File to write results to, standard output if not set.", "file");
+    QCommandLineOption noFillOption    ("no-fill",    "Don't put start, card nodes and random companies on empty cells.");
+    QCommandLineOption cardCellsOption ("card-cells", "Percent of filled empty cells, that become card nodes.", "percent", QString::number(defaults.cardCells));
+    QCommandLineOption noBuyOption     ("no-buy",     "Players never buy companies.");
+    QCommandLineOption noUpgradeOption ("no-upgrade", "Players never upgrade companies.");
+    QCommandLineOption noCardsOption   ("no-cards",   "Players never use cards.");
+
+    parser.addOptions({atOption, otOption, cardsOption, gamesOption, threadsOption, playersOption, goldOption, turnsOption,
+                       circlesOption, copiesOption, seedOption, outputOption, noFillOption, cardCellsOption, noBuyOption, noUpgradeOption, noCardsOption});
+    parser.process(app);
+
+    if (parser.positionalArguments().count() != 1)
+        parser.showHelp(1);
+
+    // 1. Settings.
+    Simulation::Settings settings;
+    settings.games           = parser.value(gamesOption).toInt();
+    settings.threads         = parser.value(threadsOption).toInt();
+    settings.players         = parser.value(playersOption).toInt();
+    settings.startGold       = parser.value(goldOption).toInt();
+    settings.maxTurns        = parser.value(turnsOption).toInt();
+    settings.circlesToFinish = parser.value(circlesOption).toInt();
+    settings.deckCopies      = parser.value(copiesOption).toInt();
+    settings.seed            = parser.value(seedOption).toULongLong();
+    settings.fillEmptyCells  = !parser.isSet(noFillOption);
+    settings.cardCells       = parser.value(cardCellsOption).toInt();
+    settings.policy.buyCompanies     = !parser.isSet(noBuyOption);
+    settings.policy.upgradeCompanies = !parser.isSet(noUpgradeOption);
+    settings.policy.useCards         = !parser.isSet(noCardsOption);
+
+    if (settings.games < 1 || settings.players < 2 || settings.maxTurns < 1 || settings.circlesToFinish < 1 || settings.deckCopies < 0)
+    {
+        qDebug() << "There should be at least one game of two players with one turn and one circle.";
+        return 1;
+    }
+
+    // 2. Catalogs and the map.
+    QList<Description*> actionTokens    = CatalogLoader::load(Description::ObjectType::ACTION_TOKEN,    parser.value(atOption));
+    QList<Description*> ownershipTokens = CatalogLoader::load(Description::ObjectType::OWNERSHIP_TOKEN, parser.value(otOption));
+    QList<Description*> cards           = CatalogLoader::load(Description::ObjectType::CARD,            parser.value(cardsOption));
+
+    GameState prototype;
+    int code = 0;
+    if (prototype.loadMap(parser.positionalArguments().first()) && !prototype.cells().isEmpty())
+    {
+        prototype.resolveTokens(actionTokens, ownershipTokens);
+
+        // 3. Play and write the results.
+        Simulation simulation (prototype, ownershipTokens, cards, settings);
+
+        QElapsedTimer timer;
+        timer.start();
+        Simulation::Results results = simulation.run();
+        qDebug() << "Games have been played in" << timer.elapsed() << "ms.";
+
+        QFile file;
+        if (parser.isSet(outputOption))
+        {
+            file.setFileName(parser.value(outputOption));
+            if (!file.open(QIODevice::WriteOnly | QIODevice::Text))
+                qDebug() << "Could not open the output file " << file.fileName();
+        }
+        else
+            file.open(stdout, QIODevice::WriteOnly | QIODevice::Text);
+
+        if (file.isOpen())
+        {
+            QTextStream out (&file);
+            simulation.report(results, out);
+        }
+        else
+            code = 1;
+    }
+    else
+    {
+        qDebug() << "Map has no nodes to play on.";
+        code = 1;
+    }
+
+    qDeleteAll(actionTokens);
+    qDeleteAll(ownershipTokens);
+    qDeleteAll(cards);
+
+    return code;
+}
@@ -0,0 +1,269 @@
+#include "simulation.h"
+
+#include <QDebug>
+#include <QThreadPool>
+#include <QtConcurrent/QtConcurrentMap>
+
+#include "core/gamerules.h"
+
+using CardType = GameTypes::CardType;
+using Stream   = GameRandom::Stream;
+
+// ****************************************************** RESULTS
+
+void Simulation::Results::prepare(const Settings &settings)
+{
+    int maxRounds = settings.maxTurns / qMax(1, settings.players) + 1;
+
+    wins.fill(0, settings.players);
+    lengths.fill(0, settings.maxTurns + 1);
+    gold.fill(QVector<qint64>(maxRounds, 0), settings.players);
+    rounds.fill(0, maxRounds);
+    cardActivations.fill(0, GameTypes::CARD_TYPES_COUNT);
+}
+
+void Simulation::Results::merge(const Results &other)
+{
+    // Results of the thread, that has not played anything yet, are just replaced.
+    if (games == 0)
+    {
+        *this = other;
+        return;
+    }
+
+    if (other.games == 0)
+        return;
+
+    games    += other.games;
+    finished += other.finished;
+    turns    += other.turns;
+
+    for (int i = 0; i < wins.count(); ++i)
+        wins[i] += other.wins.at(i);
+
+    for (int i = 0; i < lengths.count(); ++i)
+        lengths[i] += other.lengths.at(i);
+
+    for (int p = 0; p < gold.count(); ++p)
+        for (int r = 0; r < gold.at(p).count(); ++r)
+            gold[p][r] += other.gold.at(p).at(r);
+
+    for (int i = 0; i < rounds.count(); ++i)
+        rounds[i] += other.rounds.at(i);
+
+    for (int i = 0; i < cardActivations.count(); ++i)
+        cardActivations[i] += other.cardActivations.at(i);
+}
+
+// ****************************************************** SIMULATION
+
+Simulation::Simulation(const GameState &prototype,
+                       const QList<Description*> &ownershipTokens, const QList<Description*> &cards,
+                       const Settings &settings)
+    : m_prototype (prototype)
+    , m_ownershipTokens (ownershipTokens)
+    , m_settings (settings)
+{
+    // Ring is compiled once here, so the copies of the prototype, made by the threads, don't compile it again.
+    if (!m_prototype.ring().isClosed())
+        qDebug() << "Map is not a closed ring, units will walk step by step:" << m_prototype.ring().error();
+
+    if (m_prototype.findCell(GameTypes::ActionType::START) < 0)
+        qDebug() << "Map has no start node, players will start on the first node and get no wage.";
+
+    for (Description* d : cards)
+    {
+        if (d->isKnownType())
+            m_cards.append(d->cardType());
+    }
+}
+
+Simulation::Results Simulation::run() const
+{
+    if (m_settings.threads > 0)
+        QThreadPool::globalInstance()->setMaxThreadCount(m_settings.threads);
+
+    // Batches are small enough to keep all the threads busy till the end, but large enough to merge results rarely.
+    int threads   = QThreadPool::globalInstance()->maxThreadCount();
+    int batchSize = qMax(1, m_settings.games / (threads * 16));
+
+    QVector<Batch> batches;
+    for (int first = 0; first < m_settings.games; first += batchSize)
+        batches.append(Batch(first, qMin(batchSize, m_settings.games - first)));
+
+    qDebug() << "Playing" << m_settings.games << "games in" << batches.count() << "batches on" << threads << "threads.";
+
+    BatchPlayer player {this};
+    return QtConcurrent::blockingMappedReduced<Results>(batches, player, &Simulation::mergeBatch, QtConcurrent::UnorderedReduce);
+}
+
+void Simulation::report(const Results &results, QTextStream &out) const
+{
+    // Summary.
+    out << "section,summary\n";
+    out << "games," << results.games << "\n";
+    out << "finished," << results.finished << "\n";
+    out << "seed," << m_settings.seed << "\n";
+    out << "players," << m_settings.players << "\n";
+    out << "start_gold," << m_settings.startGold << "\n";
+    out << "max_turns," << m_settings.maxTurns << "\n";
+    out << "circles_to_finish," << m_settings.circlesToFinish << "\n";
+    out << "\n";
+
+    if (results.games == 0)
+        return;
+
+    // Win rates per seat.
+    out << "section,wins\n";
+    out << "player,wins,rate\n";
+    for (int p = 0; p < results.wins.count(); ++p)
+        out << p + 1 << "," << results.wins.at(p) << "," << double(results.wins.at(p)) / results.games << "\n";
+    out << "\n";
+
+    // Game length: summary and the count of games per count of turns.
+    int shortest = -1, longest = -1, median = -1, counted = 0;
+    for (int t = 0; t < results.lengths.count(); ++t)
+    {
+        if (results.lengths.at(t) == 0)
+            continue;
+
+        if (shortest < 0)
+            shortest = t;
+        longest = t;
+
+        counted += results.lengths.at(t);
+        if (median < 0 && counted * 2 >= results.games)
+            median = t;
+    }
+
+    out << "section,length\n";
+    out << "min,max,mean,median\n";
+    out << shortest << "," << longest << "," << double(results.turns) / results.games << "," << median << "\n";
+    out << "turns,games\n";
+    for (int t = 0; t < results.lengths.count(); ++t)
+        if (results.lengths.at(t) > 0)
+            out << t << "," << results.lengths.at(t) << "\n";
+    out << "\n";
+
+    // Mean gold of each seat after each round among the games, that lasted that long.
+    out << "section,gold\n";
+    out << "round,games";
+    for (int p = 0; p < results.gold.count(); ++p)
+        out << ",player" << p + 1;
+    out << "\n";
+    for (int r = 0; r < results.rounds.count() && results.rounds.at(r) > 0; ++r)
+    {
+        out << r + 1 << "," << results.rounds.at(r);
+        for (int p = 0; p < results.gold.count(); ++p)
+            out << "," << double(results.gold.at(p).at(r)) / results.rounds.at(r);
+        out << "\n";
+    }
+    out << "\n";
+
+    // Card activations in total and per game.
+    out << "section,cards\n";
+    out << "card,activations,per_game\n";
+    for (int c = 0; c < results.cardActivations.count(); ++c)
+    {
+        CardType cardType = static_cast<CardType>(c);
+        if (cardType == CardType::DEFAULT)
+            continue;
+
+        out << GameTypes::cardTypeToString(cardType) << "," << results.cardActivations.at(c) << ","
+            << double(results.cardActivations.at(c)) / results.games << "\n";
+    }
+}
+
+Simulation::Results Simulation::BatchPlayer::operator()(const Batch &batch) const
+{
+    Results results;
+    results.prepare(simulation->m_settings);
+
+    for (int game = batch.first; game < batch.first + batch.second; ++game)
+        simulation->playGame(game, results);
+
+    return results;
+}
+
+void Simulation::mergeBatch(Results &total, const Results &batch)
+{
+    total.merge(batch);
+}
+
+void Simulation::prepareGame(GameState &state) const
+{
+    // 1. Fill empty cells: start node (pay, circles and the end of the game depend on it), card nodes and random companies.
+    if (m_settings.fillEmptyCells && !state.cells().isEmpty())
+    {
+        if (state.findCell(GameTypes::ActionType::START) < 0 && state.cells().first().type == GameState::CellType::EMPTY)
+            state.setActionToken(0, GameTypes::ActionType::START);
+
+        for (int i = 0; i < state.cells().count(); ++i)
+        {
+            if (state.cells().at(i).type != GameState::CellType::EMPTY)
+                continue;
+
+            if (m_ownershipTokens.isEmpty() || state.random.bounded(Stream::SETUP, 1, 100) <= m_settings.cardCells)
+            {
+                bool positive = state.random.chance(Stream::SETUP, 50);
+                state.setActionToken(i, positive ? GameTypes::ActionType::CARD_POSITIVE : GameTypes::ActionType::CARD_NEGATIVE);
+                continue;
+            }
+
+            int index = state.random.index(Stream::SETUP, m_ownershipTokens.count());
+            state.setCompany(i, state.addCompany(m_ownershipTokens.at(index), index));
+        }
+    }
+
+    // 2. Fill and shuffle the decks.
+    for (int copy = 0; copy < m_settings.deckCopies; ++copy)
+        for (CardType cardType : m_cards)
+            state.addCard(cardType);
+
+    for (bool positive : {true, false})
+    {
+        QVector<CardType>& deck = state.deck(positive);
+        for (int i = deck.count() - 1; i > 0; --i)
+            qSwap(deck[i], deck[state.random.bounded(Stream::SETUP, 0, i)]);
+    }
+
+    // 3. Place the players on the start node.
+    int start = qMax(0, state.findCell(GameTypes::ActionType::START));
+    for (int p = 0; p < m_settings.players; ++p)
+        state.addPlayer(QString("Player %1").arg(p + 1), start, m_settings.startGold);
+}
+
+void Simulation::playGame(int game, Results &results) const
+{
+    GameState state (m_prototype);
+    state.random.reseed(m_settings.seed + quint64(game));
+    prepareGame(state);
+
+    RulesEngine engine (&state);
+    engine.setPolicy(m_settings.policy);
+
+    // Turns are made one by one to record the gold of players after each round.
+    while (state.turn < m_settings.maxTurns && !engine.isOver(m_settings.circlesToFinish))
+    {
+        engine.turn();
+
+        if (state.turn % m_settings.players == 0)
+        {
+            int round = state.turn / m_settings.players - 1;
+            ++results.rounds[round];
+            for (int p = 0; p < m_settings.players; ++p)
+                results.gold[p][round] += state.players().at(p).gold;
+        }
+    }
+
+    ++results.games;
+    ++results.wins[engine.leader()];
+    ++results.lengths[state.turn];
+    results.turns += state.turn;
+    if (engine.isOver(m_settings.circlesToFinish))
+        ++results.finished;
+
+    const QVector<int>& activations = engine.cardActivations();
+    for (int c = 0; c < activations.count(); ++c)
+        results.cardActivations[c] += activations.at(c);
+}
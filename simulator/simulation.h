@@ -0,0 +1,101 @@
+#ifndef SIMULATION_H
+#define SIMULATION_H
+
+#include <QList>
+#include <QPair>
+#include <QVector>
+#include <QTextStream>
+
+#include "core/description.h"
+#include "core/gamestate.h"
+#include "core/rulesengine.h"
+
+// Simulation plays many full games on the same map headlessly and gathers their statistics.
+// Games are played in batches by the global thread pool, each game has its own state and generator,
+// so batches don't share anything but the read-only prototype and catalogs.
+// - seed of the game with number n is settings.seed + n, so any game of the run can be replayed alone;
+// - before the game empty cells are filled (if fillEmptyCells is set): the first cell gets the start token, if the map has none,
+//   cardCells percents of the rest become nodes of positive or negative cards, like the table fills them, others get random companies;
+//   maps saved by the table keep only positions of nodes, so without filling there is no pay, no cards and no end of the game;
+// - decks get deckCopies copies of each card from the catalog and are shuffled, players are placed on the start node;
+// - results of batches are merged as soon as they are ready, the order of merging doesn't change the totals.
+
+class Simulation
+{
+public:
+    // Settings of the run:
+    // - games is the count of games to play, threads is the count of working threads (0 for all the cores);
+    // - players, startGold, maxTurns and circlesToFinish describe each game;
+    // - deckCopies is the count of copies of each card in the decks, fillEmptyCells puts start, card nodes and companies on empty cells,
+    //   cardCells is the share of filled cells in percents, that become card nodes;
+    // - policy describes the decisions of players.
+    struct Settings
+    {
+        int     games = 1000;
+        int     threads = 0;
+        int     players = 2;
+        int     startGold = 50000;
+        int     maxTurns = 1000;
+        int     circlesToFinish = 10;
+        int     deckCopies = 2;
+        bool    fillEmptyCells = true;
+        int     cardCells = 30;
+        quint64 seed = 0;
+        RulesEngine::Policy policy;
+    };
+
+    // Results are the totals of played games:
+    // - wins is the count of games won by each seat (the richest player wins);
+    // - finished is the count of games, where someone passed all the circles before turns were over;
+    // - lengths is the count of games per count of turns made, turns is the sum of them;
+    // - gold is the sum of gold of each seat after each round, rounds is the count of games, that lasted that long;
+    // - cardActivations is the count of activated cards of each type.
+    struct Results
+    {
+        int games = 0;
+        int finished = 0;
+        qint64 turns = 0;
+        QVector<int>     wins;
+        QVector<int>     lengths;
+        QVector<QVector<qint64>> gold;
+        QVector<int>     rounds;
+        QVector<qint64>  cardActivations;
+
+        void prepare (const Settings& settings);
+        void merge   (const Results& other);
+    };
+
+    // Catalogs are owned by the caller and should live as long as the simulation.
+    Simulation(const GameState& prototype,
+               const QList<Description*>& ownershipTokens, const QList<Description*>& cards,
+               const Settings& settings);
+
+    // * run plays all the games and returns the totals;
+    // * report writes the totals as CSV sections: summary, wins, length, gold and cards.
+    Results run () const;
+    void report (const Results& results, QTextStream& out) const;
+
+private:
+    using Batch = QPair<int, int>; // number of the first game and count of games
+
+    // BatchPlayer is the map functor for QtConcurrent, it plays all the games of the batch.
+    struct BatchPlayer
+    {
+        typedef Results result_type;
+
+        const Simulation* simulation;
+        Results operator() (const Batch& batch) const;
+    };
+
+    static void mergeBatch (Results& total, const Results& batch);
+
+    void prepareGame (GameState& state) const;
+    void playGame    (int game, Results& results) const;
+
+    GameState            m_prototype;
+    QList<Description*>  m_ownershipTokens;
+    QVector<GameTypes::CardType> m_cards;
+    Settings             m_settings;
+};
+
+#endif // SIMULATION_H
@@ -0,0 +1,32 @@
+TEMPLATE = app
+TARGET = monopoly-sim
+QT = core concurrent
+CONFIG += console c++11 c++14 c++17
+CONFIG -= app_bundle
+
+# Simulator is the command-line tool, that plays many games on the map using the core library and all the cores of CPU.
+# It doesn't depend on widgets, so it can run on machines without display.
+
+DEFINES += QT_DEPRECATED_WARNINGS
+DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
+
+# Game rules live in the core static library (see core/core.pro), simulator links against it.
+win32:CONFIG(release, debug|release): LIBS += -L$$OUT_PWD/../core/release/ -lmonopolycore
+else:win32:CONFIG(debug, debug|release): LIBS += -L$$OUT_PWD/../core/debug/ -lmonopolycore
+else:unix: LIBS += -L$$OUT_PWD/../core/ -lmonopolycore
+
+win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/release/libmonopolycore.a
+else:win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/debug/libmonopolycore.a
+else:win32:!win32-g++:CONFIG(release, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/release/monopolycore.lib
+else:win32:!win32-g++:CONFIG(debug, debug|release): PRE_TARGETDEPS += $$OUT_PWD/../core/debug/monopolycore.lib
+else:unix: PRE_TARGETDEPS += $$OUT_PWD/../core/libmonopolycore.a
+
+INCLUDEPATH += $$PWD/..
+DEPENDPATH  += $$PWD/../core
+
+SOURCES += \
+    main.cpp \
+    simulation.cpp
+
+HEADERS += \
+    simulation.h
@@ -9,15 +9,21 @@
 #include <QThread>
 
 #include "nodes/nodeeditor.h"
+#include "ui/assetpack.h"
+#include "ui/imagecache.h"
+#include "ui/spriteatlas.h"
+#include "ui/textcache.h"
 
 Table::Table(QWidget *parent)
     : QWidget (parent)
 {    
     activateHistory();
     prepareScene();
+    subscribeViews();
     addMenu();
 
-    setWindowIcon(QIcon("D:/monopoly/icon.png"));
+    // Icon is the asset of data directory too, so the application has one root for all its files.
+    setWindowIcon(QIcon(QPixmap::fromImage(AssetPack::instance().image("ui/icon.png"))));
 }
 
 Table::~Table()
@@ -33,6 +39,11 @@ Table::~Table()
 
     freePointers();
     nullifyPointers();
+
+    // Caches of pictures are process-wide, their pixmaps are released here, while QApplication still exists.
+    SpriteAtlas::instance().clear();
+    ImageCache::instance().clear();
+    TextCache::instance().clear();
 }
 
 // ******************************** CLEANING
@@ -50,10 +61,25 @@ void Table::clearNodes()
     for (int i = 0; i < m_nodes->count(); ++i)
     {
         Node* node = m_nodes->at(i);
+        forgetNode(node);
         delete node;
     }
 
     m_nodes->clear();
+    m_grid.clear();
+    m_bits.clear();
+    m_ringDirty = true;
+    invalidateBoard();
+}
+
+void Table::forgetNode(Node *node)
+{
+    // Companies are marked by ownership events, they are deleted together with their nodes.
+    if (!m_repaint)
+        return;
+
+    m_repaint->forget(node);
+    m_repaint->forget(node->token());
 }
 
 void Table::clearOwnershipTokensData()
@@ -68,6 +94,10 @@ void Table::clearOwnershipTokensData()
         delete m_OTDescription->at(i);
 
     m_OTDescription->clear();
+
+    // Tokens made from prototypes keep their shared data, so prototypes may go away before them.
+    qDeleteAll(m_OTPrototypes);
+    m_OTPrototypes.clear();
 }
 
 void Table::clearActionTokensData()
@@ -82,6 +112,9 @@ void Table::clearActionTokensData()
         delete m_ATDescription->at(i);
 
     m_ATDescription->clear();
+
+    qDeleteAll(m_ATPrototypes);
+    m_ATPrototypes.clear();
 }
 
 void Table::clearCardsData()
@@ -124,11 +157,9 @@ void Table::clearUnits()
         return;
     }
 
-    // delete all the players from the list
-    for (int i = 0; i < m_units->count(); ++i)
-        removeUnit(m_units->at(i));
-
-    m_units->clear();    
+    // delete all the players from the list, each of them is removed from it by removeUnit
+    while (!m_units->isEmpty())
+        removeUnit(m_units->first());
 
     // also reinitialize the current player variables    
     m_currentPlayer = nullptr;
@@ -159,6 +190,7 @@ void Table::freePointers()
     pb_saveMap->deleteLater();
     pb_loadMap->deleteLater();
     pb_turn->deleteLater();
+    pb_skipAnimation->deleteLater();
     l_turn->deleteLater();
     m_layout->deleteLater();
 
@@ -191,6 +223,7 @@ void Table::nullifyPointers()
     m_nodes = nullptr;
     m_view = nullptr;
     m_scene = nullptr;
+    m_board = nullptr;
 }
 
 // ********************************** KEYBOARD AND MOUSE EVENTS
@@ -233,6 +266,10 @@ void Table::keyPressEvent(QKeyEvent *event)
         step (m_currentPlayer, Player::Direction::DOWN);
         break;
 
+        case Qt::Key_F:
+        advanceTurns(FAST_FORWARD_TURNS);
+        break;
+
         case Qt::Key_Space:
         break;
 
@@ -352,12 +389,16 @@ void Table::mousePressEvent(QMouseEvent *event)
                     if (button->text() == "Buy")
                     {
                         m_currentPlayer->takeOwnershipToken(ownershipToken);
+                        emit m_events.ownershipChanged(ownershipToken, nullptr, m_currentPlayer);
+                        emit m_events.goldChanged(m_currentPlayer);
                         l_history->addMessage(QString("Player %1 bought company %2 for %3 gold.").arg(m_currentPlayer->name()).arg(ownershipToken->name()).arg(ownershipToken->buyingCost()));
                     }
 
                     if (button->text().startsWith("Upgrade"))
                     {
                         ownershipToken->upgrade(false);
+                        emit m_events.companiesChanged(m_currentPlayer);
+                        emit m_events.goldChanged(m_currentPlayer);
                         l_history->addMessage(QString("Player %1 upgraded company %2 to level %3.").arg(m_currentPlayer->name()).arg(ownershipToken->name()).arg(ownershipToken->upgradeLevel()));
                     }
                 }
@@ -369,13 +410,13 @@ void Table::mousePressEvent(QMouseEvent *event)
                     qDebug() << QString("Card selected. Name: %1. Type: %2.").arg(card->name()).arg(card->typeToString(card->cardType()));
 
                     if (button->text().startsWith("Use"))
-                        activate(card);
+                        useCard(card);
 
                     details->clearSelection();
                 }
 
-                m_details->update();
-                m_currentPlayer->hand()->update();
+                m_repaint->invalidate(m_details);
+                m_repaint->invalidate(m_currentPlayer->hand());
             }
 
             // User clicked on one of the decks.
@@ -385,8 +426,7 @@ void Table::mousePressEvent(QMouseEvent *event)
                 if (!deck->isEmpty())
                 {
                     qDebug() << "There is a deck and it is not empty.";
-                    deck->peekTop()->turnAround();
-                    deck->update();
+                    deck->turnTop();
                 }
             }
 
@@ -502,10 +542,23 @@ void Table::showMenu()
     m_menu->setHidden(false);
 }
 
+void Table::setSeed(quint64 seed)
+{
+    m_seed = seed;
+    m_seedFixed = true;
+}
+
+void Table::setFiles(const Files &files)
+{
+    m_files = files;
+}
+
 void Table::newGame()
 {    
     hideMenu();
 
+    m_random.reseed(m_seedFixed ? m_seed : GameRandom::randomSeed());
+
     addGrid();
     addNodes();
     addDecks();
@@ -514,18 +567,49 @@ void Table::newGame()
     addUIWidgets();
     addUIItems();
 
-    loadDescriptions("action_tokens",    "d:/monopoly/at/at.xml");
-    loadDescriptions("ownership_tokens", "d:/monopoly/ot/ot.xml");
-    loadDescriptions("cards",            "d:/monopoly/cards/cards.xml");
+    const AssetPack& assets = AssetPack::instance();
+    loadDescriptions("action_tokens",    assets.fileFor(m_files.actionTokens));
+    loadDescriptions("ownership_tokens", assets.fileFor(m_files.ownershipTokens));
+    loadDescriptions("cards",            assets.fileFor(m_files.cards));
     l_history->addMessage(QString("Descriptions were loaded. Among them there're %1 action tokens, %2 ownership tokens and %3 cards. Total objects: %4.")
                           .arg(m_ATDescription->count()).arg(m_OTDescription->count()).arg(m_CDescription->count())
                           .arg(m_ATDescription->count() + m_OTDescription->count() + m_CDescription->count()));
 
+    l_history->addMessage(QString("Game seed: %1.").arg(m_random.seed()));
+
     setMovementConstraint(Constraint::COUNTER_CLOCKWISE);
     setMode(Mode::PLAY);
     onDefaults();
 }
 
+void Table::populate(int handTokens)
+{
+    newGame();
+    fillHandsWithRandomTokens(handTokens);
+
+    if (m_units->isEmpty())
+        return;
+
+    // Details of the first unit and the node it stands on are shown the way the play shows them.
+    Player* player = m_units->first();
+    Node* node = getNodeAt(player->gridPosition(), true);
+
+    m_details->setPlayer(player);
+    m_details->setToken(node ? node->token() : nullptr);
+    m_details->show();
+    m_details->showButtons();
+}
+
+QGraphicsScene *Table::scene() const
+{
+    return m_scene;
+}
+
+const TurnScheduler &Table::scheduler() const
+{
+    return m_scheduler;
+}
+
 void Table::quit()
 {
     qApp->quit();
@@ -535,7 +619,12 @@ void Table::quit()
 
 Node *Table::createNode(const QPoint& gridPosition)
 {
-    Node *node = new Node(gridPosition);
+    // There may be only one node per grid position.
+    Node *node = lookForNodeAt(gridPosition);
+    if (node)
+        return node;
+
+    node = new Node(gridPosition);
     node->setRect(QRect(gridPosition.x() * NODE_WIDTH, gridPosition.y() * NODE_HEIGHT, NODE_WIDTH, NODE_HEIGHT));    
 
     addNode(node);
@@ -544,21 +633,28 @@ Node *Table::createNode(const QPoint& gridPosition)
 
 void Table::addNode(Node *n)
 {
-    if (!m_nodes->contains(n))
+    if (!m_grid.contains(n->gridPosition()))
     {
         m_nodes->append(n);
-        m_scene->addItem(n);
+        m_grid.set(n->gridPosition(), n);
+        m_bits.addNode(n->gridPosition());
+        indexToken(n);
+        m_ringDirty = true;
     }
 }
 
 void Table::removeNode(Node *n)
 {
-    if (m_nodes->contains(n))
+    if (m_grid.at(n->gridPosition()) == n)
     {
         m_nodes->removeOne(n);
-        m_scene->removeItem(n);
+        m_grid.remove(n->gridPosition());
+        m_bits.removeNode(n->gridPosition());
+        m_ringDirty = true;
 
+        forgetNode(n);
         delete n;
+        invalidateBoard();
     }
 }
 
@@ -594,12 +690,21 @@ void Table::removeUnit(Player *u)
 {
     if (m_units->contains(u))
     {
+        // Tasks of the turn, that is not over yet, refer to the units, so the turn is dropped together with any of them.
+        m_scheduler.clear();
+        if (m_movingPlayer == u)
+            m_movingPlayer = nullptr;
+        if (m_currentPlayer == u)
+            m_currentPlayer = nullptr;
+
         if (u->hand())
             u->hand()->clear();
 
         m_units->removeOne(u);
         m_scene->removeItem(u->hand());
         m_scene->removeItem(u);
+        m_repaint->forget(u->hand());
+        m_repaint->forget(u);
 
         qDebug() << QString("There are %1 players in units list").arg(m_units->count());
 
@@ -659,6 +764,7 @@ void Table::editNode(Node *node)
         {
             // Take previous token and remove it
             Token* old = node->token();
+            m_repaint->forget(old);
             delete old;
             old = nullptr;
 
@@ -670,6 +776,7 @@ void Table::editNode(Node *node)
                 token = OTFor(OTidx);
 
             node->setToken(token);
+            indexToken(node);
 
             // History relevant stuff.
             l_history->addMessage(QString("User chose action token %1 in the editor.").arg(token->name()));
@@ -683,25 +790,36 @@ void Table::editNode(Node *node)
             token->setImage(editor.imagePath());
         }
 
-        node->update();
+        invalidateBoard();
     }
 }
 
+void Table::indexToken(Node *n)
+{
+    ActionToken*    AT = dynamic_cast<ActionToken*>(n->token());
+    OwnershipToken* OT = dynamic_cast<OwnershipToken*>(n->token());
+
+    if (AT)
+        m_bits.setAction(n->gridPosition(), AT->actionType());
+    else if (OT)
+        m_bits.setCompany(n->gridPosition());
+    else
+        m_bits.clearToken(n->gridPosition());
+
+    // Node itself is already in the list, so the board shows it with the new token.
+    invalidateBoard();
+}
+
 // ****************************************** INTERACTIONS
 
 void Table::action(ActionToken::ActionType actionType)
 {
+    // Keep in step with RulesEngine::action, the simulator plays the game by that one.
     switch (actionType)
     {
     // + give player some gold, set set num of passed circles, update hand region
     case ActionToken::ActionType::START:
-        {
-            m_currentPlayer->circle();                // passed circles stats
-            m_currentPlayer->hand()->receive(20000);  // wage per passed circle
-            m_currentPlayer->hand()->returns();       // returns from the ownings
-
-            m_scene->update(m_currentPlayer->hand()->rect());
-        }
+        passStart(m_currentPlayer);
         break;
 
     // + find next node with the start action token and move player there, activate start action
@@ -710,8 +828,7 @@ void Table::action(ActionToken::ActionType actionType)
             Node* start = findNodeByName("start");
             if (start)
             {
-                m_currentPlayer->setGridPosition(start->gridPosition());
-                m_currentPlayer->setRect(start->rect());
+                placeUnit(m_currentPlayer, start);
 
                 action(ActionToken::ActionType::START);
             }
@@ -742,20 +859,27 @@ void Table::action(ActionToken::ActionType actionType)
 
     // +- take the card from the deck of positive bonuses
     case ActionToken::ActionType::CARD_POSITIVE:        
-        m_currentPlayer->takeCard(m_cardsP->takeTop());
-        m_scene->update(m_currentPlayer->hand()->rect());
+        {
+            Card* card = m_cardsP->takeTop();
+            m_currentPlayer->takeCard(card);
+            emit m_events.cardTaken(m_currentPlayer, card);
+        }
         break;
 
     // +- take the card from the deck of negative bonuses
     case ActionToken::ActionType::CARD_NEGATIVE:
-        m_currentPlayer->takeCard(m_cardsN->takeTop());
-        m_scene->update(m_currentPlayer->hand()->rect());
+        {
+            Card* card = m_cardsN->takeTop();
+            m_currentPlayer->takeCard(card);
+            emit m_events.cardTaken(m_currentPlayer, card);
+        }
         break;
     }
 }
 
 void Table::activate(Card* card)
 {
+    // Keep in step with RulesEngine::activate, the simulator plays the game by that one.
     qDebug() << "Card activated: " << card->typeToString(card->cardType());
 
     if (m_units->count() < 2)
@@ -779,12 +903,12 @@ void Table::activate(Card* card)
             //    The amount of gold is in range [5000; 10000] with a step of 500.
             qDebug() << "Treasure card activated";
 
-            int gold = 5000 + 500 * (0 + rand()%11);
+            int gold = GameRules::treasureGold(m_random);
             qDebug() << QString("The player %1 is about to receive %2 gold.").arg(m_currentPlayer->name()).arg(gold);
             qDebug() << QString("He has hands to hold his goods: %1.").arg(m_currentPlayer->hand() != nullptr);
 
             m_currentPlayer->hand()->receive(gold);
-            m_scene->update(m_currentPlayer->hand()->rect());
+            emit m_events.goldChanged(m_currentPlayer);
         }
         break;
 
@@ -796,6 +920,7 @@ void Table::activate(Card* card)
             qDebug() << "Overtime card activated";
 
             m_currentPlayer->hand()->setIncomeDoubled(true);
+            emit m_events.companiesChanged(m_currentPlayer);
         }
         break;
 
@@ -807,10 +932,8 @@ void Table::activate(Card* card)
             // 3. Actual movement.
             qDebug() << "Masterchef card activated";
 
-            int  chance   = 100;              // 10 percent chance to double the count of steps
-            int  drop     = rand()%101;
-            bool success  = (drop <= chance); // if random value is in range [0; 10], then success is true, otherwise false
-            qDebug() << QString("Chance is %1%. Dropped: %2. Success: %3").arg(chance).arg(drop).arg(success ? "yes" : "no");
+            bool success  = GameRules::chance(m_random, GameRules::MASTERCHEF_CHANCE);
+            qDebug() << QString("Chance is %1%. Success: %2").arg(GameRules::MASTERCHEF_CHANCE).arg(success ? "yes" : "no");
 
             m_stepsLeft = dropDie(1,6); // raw count of steps left on this turn
             m_stepsLeft = (success) ? 2 * m_stepsLeft : m_stepsLeft; // count of steps including chance of doubling
@@ -831,7 +954,7 @@ void Table::activate(Card* card)
             qDebug() << "Fast and furious card activated";
 
             setMovementSpeed(5);
-            m_stepsLeft = NODES_PER_ROW + NODES_PER_COLUMN - 1; // half-circle, move this to some method later
+            m_stepsLeft = GameRules::halfRingSteps(NODES_PER_ROW, NODES_PER_COLUMN);
             startMovement(m_currentPlayer);
         }
         break;
@@ -851,8 +974,11 @@ void Table::activate(Card* card)
                 {
                     int gold = p->hand()->gold();
 
-                    p->hand()->pay(gold >= 5000 ? 5000 : gold);
-                    m_currentPlayer->hand()->receive(gold >= 5000 ? 5000 : gold);
+                    p->hand()->pay(gold >= GameRules::BIRTHDAY_GIFT ? GameRules::BIRTHDAY_GIFT : gold);
+                    m_currentPlayer->hand()->receive(gold >= GameRules::BIRTHDAY_GIFT ? GameRules::BIRTHDAY_GIFT : gold);
+
+                    emit m_events.goldChanged(p);
+                    emit m_events.goldChanged(m_currentPlayer);
                 }
             }
         }
@@ -864,7 +990,8 @@ void Table::activate(Card* card)
             // 1. Choose random company from the list of current players' ownings and add 1 star to it without any payments. Our scientist works for food!
             qDebug() << "Scientist card activated";
 
-            m_currentPlayer->hand()->upgradeRandomCompany(1);
+            m_currentPlayer->hand()->upgradeRandomCompany(1, m_random);
+            emit m_events.companiesChanged(m_currentPlayer);
         }
         break;
 
@@ -883,8 +1010,33 @@ void Table::activate(Card* card)
             qDebug() << QString("There are %1 players total.").arg(m_units->count());
             qDebug() << QString("Each of them should make %1 steps.").arg(m_stepsLeft);
 
-            connect(&m_autoMovementTogetherTimer, SIGNAL(timeout()), this, SLOT(autoMovementTogether()));
-            m_autoMovementTogetherTimer.start(150);
+            // All the units make their steps at the same tick, without animation they make the whole movement at once.
+            int steps = m_stepsLeft / m_units->count();
+            m_scheduler.schedule(TurnScheduler::Phase::MOVE, [this, steps, made = 0]() mutable
+            {
+                bool instant = (m_scheduler.mode() == TurnScheduler::Mode::SYNCHRONOUS);
+                for (int i = 0; i < m_units->count(); ++i)
+                {
+                    Player* player = m_units->at(i);
+                    if (instant)
+                    {
+                        moveInstantly(player, steps - made);
+                        continue;
+                    }
+
+                    stepAuto(player);
+
+                    ActionToken* AT = dynamic_cast<ActionToken*>(getNodeAt(player->gridPosition(), true)->token());
+                    if (AT && AT->actionType() == ActionToken::ActionType::START)
+                        passStart(player);
+                }
+
+                m_stepsLeft = 0;
+                made = instant ? steps : made + 1;
+                updateUI();
+
+                return (made >= steps);
+            }, STEP_INTERVAL);
         }
         break;
 
@@ -904,10 +1056,13 @@ void Table::activate(Card* card)
             if (opponent)
             {
                 int goldOfOpponent = opponent->hand()->gold();
-                int goldToSteal = 5000 + 250*rand()%11; // from 5000 to 7500
+                int goldToSteal = GameRules::thiefGold(m_random); // from 5000 to 7500
 
                 opponent->hand()->pay(goldToSteal <= goldOfOpponent ? goldToSteal : goldOfOpponent);
                 m_currentPlayer->hand()->receive(goldToSteal <= goldOfOpponent ? goldToSteal : goldOfOpponent);
+
+                emit m_events.goldChanged(opponent);
+                emit m_events.goldChanged(m_currentPlayer);
             }
             else
             {
@@ -964,14 +1119,13 @@ void Table::activate(Card* card)
                 if (p != m_currentPlayer)
                 {
                     // separate chance for each opponent
-                    int chance = 100;
-                    int drop = rand()%101;
-                    bool success = (drop <= chance) ? true : false;
-                    qDebug() << QString("Chance is %1%. Dropped: %2. Success: %3").arg(chance).arg(drop).arg(success ? "yes" : "no");
+                    bool success = GameRules::chance(m_random, GameRules::SABOTAGE_CHANCE);
+                    qDebug() << QString("Chance is %1%. Success: %2").arg(GameRules::SABOTAGE_CHANCE).arg(success ? "yes" : "no");
 
                     if (success)
                     {
                         p->hand()->setIncomeStopped(true);
+                        emit m_events.companiesChanged(p);
                         qDebug() << QString("Income for companies of %1 is stopped for 1 circle.").arg(p->name());
                     }
                 }
@@ -987,10 +1141,8 @@ void Table::activate(Card* card)
             // 3. Remove the OT from the opponent and place it in current players hand.
             qDebug() << "Raid card activated";
 
-            int chance = 100;
-            int drop = rand()%101;
-            bool success = (drop <= chance) ? true : false;
-            qDebug() << QString("Chance is %1%. Dropped: %2. Success: %3").arg(chance).arg(drop).arg(success ? "yes" : "no");
+            bool success = GameRules::chance(m_random, GameRules::RAID_CHANCE);
+            qDebug() << QString("Chance is %1%. Success: %2").arg(GameRules::RAID_CHANCE).arg(success ? "yes" : "no");
 
             if (success)
             {
@@ -999,15 +1151,14 @@ void Table::activate(Card* card)
                 qDebug() << "here";
                 if (opponent)
                 {
-                    OwnershipToken* OT = opponent->hand()->randomCompany();
+                    OwnershipToken* OT = opponent->hand()->randomCompany(m_random);
 
                     if (OT)
                     {
                         opponent->hand()->removeToken(OT);
                         m_currentPlayer->hand()->addToken(OT);
 
-                        m_scene->update(opponent->hand()->rect());
-                        m_scene->update(m_currentPlayer->hand()->rect());
+                        emit m_events.ownershipChanged(OT, opponent, m_currentPlayer);
                     }
                     else
                     {
@@ -1036,7 +1187,7 @@ void Table::activate(Card* card)
             // 6. Initiate the jail action.
             qDebug() << "Bribe card activated";
 
-            int gold = 2500 + 250*rand()%11; // [2500;5000] for bribe
+            int gold = GameRules::bribeGold(m_random); // [2500;5000] for bribe
             if (m_currentPlayer->hand()->gold() < gold)
             {
                 qDebug() << QString("Card was not activated. Player %1 hasn't enough money to initiate the bribe.").arg(m_currentPlayer->name());
@@ -1044,23 +1195,21 @@ void Table::activate(Card* card)
                 return;
             }
 
-            int chance = 100;
-            int drop = rand()%101;
-            bool success = (drop <= chance) ? true : false;
-            qDebug() << QString("Chance is %1%. Dropped: %2. Success: %3").arg(chance).arg(drop).arg(success ? "yes" : "no");
+            bool success = GameRules::chance(m_random, GameRules::BRIBE_CHANCE);
+            qDebug() << QString("Chance is %1%. Success: %2").arg(GameRules::BRIBE_CHANCE).arg(success ? "yes" : "no");
 
             if (success)
             {
                 m_currentPlayer->hand()->pay(gold);
+                emit m_events.goldChanged(m_currentPlayer);
 
-                int turns = 1 + rand() % (1 + rand() % 4); // [1;4] turns of jail with significantly lower chance to get more turns
+                int turns = GameRules::bribeTurns(m_random); // [1;4] turns of jail with significantly lower chance to get more turns
 
                 Node* jailNode = findNodeByName("prison");
                 if (jailNode)
                 {
                     Player* opponent = randomOpponent();
-                    opponent->setRect(jailNode->rect());
-                    opponent->setGridPosition(jailNode->gridPosition());
+                    placeUnit(opponent, jailNode);
                     opponent->setBlocked(turns);
                 }
                 else
@@ -1089,9 +1238,7 @@ void Table::activate(Card* card)
 
             if (opponent)
             {
-                Node* node = getNodeAt(opponent->gridPosition(), true);
-                m_currentPlayer->setGridPosition(node->gridPosition());
-                m_currentPlayer->setRect(node->rect());
+                placeUnit(m_currentPlayer, getNodeAt(opponent->gridPosition(), true));
             }
             else
             {
@@ -1109,11 +1256,8 @@ void Table::activate(Card* card)
             // 3. Upgrade random company of current player by the same count of stars.
             qDebug() << "Spy card activated";
 
-            int chance = 100;
-            int drop   = rand()%101;
-            bool success = (drop <= chance) ? true : false;
-
-            qDebug() << QString("Chance is %1%. Dropped: %2. Success: %3").arg(chance).arg(drop).arg(success ? "yes" : "no");
+            bool success = GameRules::chance(m_random, GameRules::SPY_CHANCE);
+            qDebug() << QString("Chance is %1%. Success: %2").arg(GameRules::SPY_CHANCE).arg(success ? "yes" : "no");
 
             if (success)
             {
@@ -1123,7 +1267,10 @@ void Table::activate(Card* card)
                 {
                     int stars = opponent->hand()->topCompanyUpgradeLevel(); // returns 0 if opponent hasn't any companies
                     if (stars > 0)
-                        m_currentPlayer->hand()->upgradeRandomCompany(stars);
+                    {
+                        m_currentPlayer->hand()->upgradeRandomCompany(stars, m_random);
+                        emit m_events.companiesChanged(m_currentPlayer);
+                    }
                     else
                     {
                         qDebug() << QString("Card was not activated. Opponent %1 hasn't any companies with upgrades.").arg(opponent->name());
@@ -1152,15 +1299,17 @@ void Table::activate(Card* card)
         // if (m_cardsN->has(m_currentCard)) m_cardsN->remove(m_currentCard);
 
         qDebug() << "Deleting card: " << m_currentPlayer->name();
-        m_currentPlayer->hand()->removeCard(m_currentCard);
+        m_currentPlayer->hand()->removeCard(card);
+        emit m_events.cardUsed(m_currentPlayer, card);
 
-        m_scene->update(m_currentPlayer->hand()->rect());
-        m_scene->removeItem(m_currentCard);
+        m_scene->removeItem(card);
         m_details->hideButtons();
         m_details->hide();
 
-        delete m_currentCard;
-        m_currentCard = nullptr;
+        if (m_currentCard == card)
+            m_currentCard = nullptr;
+        m_repaint->forget(card);
+        delete card;
     }
 }
 
@@ -1174,12 +1323,16 @@ void Table::prepareScene()
     m_scene =  new QGraphicsScene (0, 0, basewidth, baseheight, this);
     m_scene->setBackgroundBrush(QBrush(QColor("#444")));
 
+    m_repaint = new RepaintQueue (m_scene, this);
+    m_repaint->setUIUpdater([this]() { refreshUI(); });
+
     m_view  = new View (m_scene, this);   
     m_view->setHorizontalScrollBarPolicy(Qt::ScrollBarAlwaysOff);
     m_view->setVerticalScrollBarPolicy(Qt::ScrollBarAlwaysOff);    
     connect(m_view, SIGNAL(mousePositionChanged(const QPoint&)), this, SLOT(viewMousePositionChanged(const QPoint&)));
 
     m_nodes = new QList<Node*>();
+    m_grid.reset(NODES_PER_ROW, NODES_PER_COLUMN);
     m_units = new QList<Player*>();
     m_currentPlayer = nullptr;
 
@@ -1195,23 +1348,19 @@ void Table::prepareScene()
 
 void Table::addGrid()
 {
-    QPen pen;
-    QPen pen_inner (QBrush(Qt::gray), 1, Qt::DashLine);
-    QPen pen_border (QBrush(Qt::darkGray), 2, Qt::SolidLine);
+    // Grid lines are drawn by the static layer of the board together with nodes and tokens.
+    if (m_board)
+        return;
 
-    // Vertical lines
-    for (int x = 0; x <= basewidth; x += NODE_WIDTH)
-    {
-        pen = (x == 0 || x == basewidth) ? pen_border : pen_inner;
-        m_scene->addLine(QLineF(x, 0, x, baseheight), pen);
-    }
+    m_board = new BoardLayer (QSize(NODE_WIDTH, NODE_HEIGHT), NODES_PER_ROW, NODES_PER_COLUMN);
+    m_board->setNodes(m_nodes, &m_grid);
+    m_scene->addItem(m_board);
+}
 
-    // Horizontal lines
-    for (int y = 0; y <= baseheight; y += NODE_HEIGHT)
-    {
-        pen = (y == 0 || y == baseheight) ? pen_border : pen_inner;
-        m_scene->addLine(QLineF(0, y, basewidth, y), pen);
-    }   
+void Table::invalidateBoard()
+{
+    if (m_board)
+        m_board->invalidate();
 }
 
 void Table::addHands()
@@ -1274,21 +1423,26 @@ void Table::addUIWidgets()
     pb_loadMap  = new QPushButton ("Load map");
     pb_defaults = new QPushButton ("Defaults");
     pb_turn     = new QPushButton ("Make turn");
+    pb_skipAnimation = new QPushButton ("Skip animation");
 
     pb_editMode->setCheckable(true);
     pb_editMode->setChecked(false);
+    pb_skipAnimation->setCheckable(true);
+    pb_skipAnimation->setChecked(m_instantMovement);
 
     pb_editMode->setFixedWidth(100);
     pb_saveMap->setFixedWidth(100);
     pb_loadMap->setFixedWidth(100);
     pb_defaults->setFixedWidth(100);
     pb_turn->setFixedWidth(75);
+    pb_skipAnimation->setFixedWidth(100);
 
     connect (pb_editMode, SIGNAL(clicked()), this, SLOT(onEditMode()));
     connect (pb_saveMap, SIGNAL(clicked()), this, SLOT(onSaveMap()));
     connect (pb_loadMap, SIGNAL(clicked()), this, SLOT(onLoadMap()));
     connect (pb_defaults, SIGNAL(clicked()), this, SLOT(onDefaults()));
     connect (pb_turn, SIGNAL(clicked()), this, SLOT(onTurn()));
+    connect (pb_skipAnimation, SIGNAL(clicked()), this, SLOT(onSkipAnimation()));
 
     l_turn  = new QLabel ("Current turn: ");
     l_steps = new QLabel ("Steps left: ");
@@ -1296,15 +1450,16 @@ void Table::addUIWidgets()
     m_layout = new QGridLayout (this);
     m_layout->setSpacing(0);
     m_layout->setMargin(0);
-    m_layout->addWidget(m_view,      0, 0, 3, 7);
-    m_layout->addWidget(l_history,   3, 0, 1, 7);
+    m_layout->addWidget(m_view,      0, 0, 3, 8);
+    m_layout->addWidget(l_history,   3, 0, 1, 8);
     m_layout->addWidget(pb_editMode, 4, 0, 1, 1);
     m_layout->addWidget(pb_saveMap,  4, 1, 1, 1);
     m_layout->addWidget(pb_loadMap,  4, 2, 1, 1);
     m_layout->addWidget(pb_defaults, 4, 3, 1, 1);
     m_layout->addWidget(pb_turn,     4, 4, 1, 1);
-    m_layout->addWidget(l_turn,      4, 5, 1, 1);
-    m_layout->addWidget(l_steps,     4, 6, 1, 1);
+    m_layout->addWidget(pb_skipAnimation, 4, 5, 1, 1);
+    m_layout->addWidget(l_turn,      4, 6, 1, 1);
+    m_layout->addWidget(l_steps,     4, 7, 1, 1);
     setLayout(m_layout);
 
     setFixedWidth(m_scene->width());
@@ -1384,7 +1539,7 @@ void Table::addUIItems()
     m_status->setPos(5*basewidth / 8, 1.25f*baseheight / 8);
     m_status->setSize(szStatus);
     m_status->setShape(UIElement::Shape::ROUNDED_RECTANGLE);
-    m_status->setFont(QFont("Comic Sans", NODE_WIDTH / 8, false));
+    m_status->setFont(PaintResources::Font::STATUS);
     m_status->setBorderWidth(3);
     m_status->setHidden(false);
 
@@ -1406,8 +1561,16 @@ void Table::hideUIItems()
 }
 
 void Table::updateUI()
+{
+    // Labels and status are refreshed once per frame, however many times they were changed.
+    m_repaint->invalidateUI();
+}
+
+void Table::refreshUI()
 {
     // LATER: remove labels and move everything to text rectangles.
+    if (m_currentPlayer == nullptr || m_status == nullptr)
+        return;
 
     // 1. Generate new message and set it to status widgets and items.
     QString text = QString("P: %1 (%2). Steps: %3. Blocked: %4").arg(m_currentPlayer->name()).arg(m_currentPlayerIndex).arg(m_stepsLeft).arg(m_currentPlayer->blocked());
@@ -1421,6 +1584,86 @@ void Table::updateUI()
     m_scene->update(m_status->rect());
 }
 
+void Table::suspendRendering()
+{
+    if (m_renderingSuspended++ > 0)
+        return;
+
+    m_view->setUpdatesEnabled(false);
+    l_history->suspend();
+    m_repaint->suspend();
+}
+
+void Table::resumeRendering()
+{
+    if (m_renderingSuspended == 0 || --m_renderingSuspended > 0)
+        return;
+
+    // Everything, that has been changed while rendering was suspended, is redrawn once.
+    l_history->resume();
+
+    if (m_detailsDirty)
+    {
+        m_detailsDirty = false;
+        m_details->show();
+        m_details->showButtons();
+        m_repaint->invalidate(m_details);
+    }
+
+    m_repaint->resume();
+    m_view->setUpdatesEnabled(true);
+}
+
+void Table::subscribeViews()
+{
+    // Views don't repaint themselves on each event, they only mark what has changed.
+    // Repaint queue then repaints each marked region once per frame.
+    connect(&m_events, &GameEvents::goldChanged, this, [this](Player* player)
+    {
+        m_repaint->invalidate(player->hand());
+        m_repaint->invalidate(m_details);
+    });
+
+    connect(&m_events, &GameEvents::companiesChanged, this, [this](Player* player)
+    {
+        m_repaint->invalidate(player->hand());
+        m_repaint->invalidate(m_details);
+    });
+
+    connect(&m_events, &GameEvents::ownershipChanged, this, [this](OwnershipToken* company, Player* previous, Player* owner)
+    {
+        if (previous)
+            m_repaint->invalidate(previous->hand());
+        if (owner)
+            m_repaint->invalidate(owner->hand());
+
+        m_repaint->invalidate(company);
+        m_repaint->invalidate(m_details);
+    });
+
+    connect(&m_events, &GameEvents::unitMoved, this, [this](Player*, const QPoint& from, const QPoint& to)
+    {
+        m_repaint->invalidate(QRectF(from.x() * NODE_WIDTH, from.y() * NODE_HEIGHT, NODE_WIDTH, NODE_HEIGHT));
+        m_repaint->invalidate(QRectF(to.x()   * NODE_WIDTH, to.y()   * NODE_HEIGHT, NODE_WIDTH, NODE_HEIGHT));
+        m_repaint->invalidateUI();
+    });
+
+    connect(&m_events, &GameEvents::cardTaken, this, [this](Player* player, Card*)
+    {
+        m_repaint->invalidate(player->hand());
+        m_repaint->invalidate(m_cardsP);
+        m_repaint->invalidate(m_cardsN);
+    });
+
+    // Used card is deleted right after the event, so only the hand, that held it, is marked.
+    connect(&m_events, &GameEvents::cardUsed, this, [this](Player* player, Card*)
+    {
+        m_repaint->invalidate(player->hand());
+        m_repaint->invalidate(m_details);
+        m_repaint->invalidateUI();
+    });
+}
+
 // ***************************************** HANDS SPECIFIC METHODS
 
 void Table::addPainterPath(Hand::Side side, const QVector<QPointF>& polygon)
@@ -1468,24 +1711,20 @@ QPair<Hand::Side, QPainterPath>* Table::handAt(const Hand::Side &side)
 
 bool Table::hasNeighbourNode(const QPoint& pixelPosition, Player::Direction direction)
 {
-    return (getNodeAt(gridPosition(pixelPosition) + directionToVector(direction), true) != nullptr);
+    return m_grid.contains(gridPosition(pixelPosition) + directionToVector(direction));
 }
 
 QBitArray Table::checkNeighbours (const QPoint &pixelPosition)
 {
-    // Neighbours are stored in an bitfield using next sequence: L-R-U-D-LU-LD-RU-RD
-
-    QBitArray neighbours (8);
+    // Neighbours are stored in an bitfield using next sequence: L-R-U-D-LU-LD-RU-RD.
+    // Bitboards (or the grid index for maps larger than 8x8) build the mask in the same sequence, so each bit is simply copied.
 
-    neighbours.setBit(0, hasNeighbourNode(pixelPosition, Player::Direction::LEFT)  ? 1 : 0);
-    neighbours.setBit(1, hasNeighbourNode(pixelPosition, Player::Direction::RIGHT) ? 1 : 0);
-    neighbours.setBit(2, hasNeighbourNode(pixelPosition, Player::Direction::UP)    ? 1 : 0);
-    neighbours.setBit(3, hasNeighbourNode(pixelPosition, Player::Direction::DOWN)  ? 1 : 0);
+    QPoint position = gridPosition(pixelPosition);
+    quint8 mask = m_bits.isValid() ? m_bits.neighbours(position) : m_grid.neighbours(position);
 
-    neighbours.setBit(4, hasNeighbourNode(pixelPosition, Player::Direction::LEFT_UP)    ? 1 : 0);
-    neighbours.setBit(5, hasNeighbourNode(pixelPosition, Player::Direction::LEFT_DOWN)  ? 1 : 0);
-    neighbours.setBit(6, hasNeighbourNode(pixelPosition, Player::Direction::RIGHT_UP)   ? 1 : 0);
-    neighbours.setBit(7, hasNeighbourNode(pixelPosition, Player::Direction::RIGHT_DOWN) ? 1 : 0);
+    QBitArray neighbours (8);
+    for (int i = 0; i < neighbours.size(); ++i)
+        neighbours.setBit(i, mask & (1 << i));
 
     return neighbours;
 }
@@ -1494,7 +1733,11 @@ QBitArray Table::checkNeighbours (const QPoint &pixelPosition)
 
 bool Table::addingIsValid(const QPoint &pixelPosition)
 {
-    // If there is an item on that position, do nothing.
+    // If there is a node or an item on that position, do nothing.
+    // Nodes are painted by the board layer, so they are not items of the scene anymore.
+    if (lookForNodeAt(gridPosition(pixelPosition)))
+        return false;
+
     QGraphicsItem *item = m_view->itemAt(pixelPosition);
     if (item)
         return false;
@@ -1611,27 +1854,42 @@ Node *Table::getNodeAt(const QPoint &position, bool onGrid)
 
 Node *Table::lookForNodeAt(const QPoint &gridPosition)
 {
-    qDebug() << "Looking for node at" << gridPosition;
+    // Nodes are indexed by their grid positions, so there is no need to look through the whole list.
+    return m_grid.at(gridPosition);
+}
 
-    for (int i = 0; i < m_nodes->count(); ++i)
+QList<Node*> Table::findNodesByType(ActionToken::ActionType actionType)
+{
+    QList<Node*> found;
+
+    // Each set bit of the bitboard is one node, the lowest one is cleared after it has been taken.
+    if (m_bits.isValid())
     {
-        Node *node = m_nodes->at(i);
+        for (quint64 board = m_bits.actions(actionType); board; board &= board - 1)
+            found.append(lookForNodeAt(Bitboard::position(Bitboard::first(board))));
 
-        if (node)
-        {
-            if (node->gridPosition() == gridPosition)
-            {
-                qDebug() << "Node found!";
-                return node;
-            }
-        }
+        return found;
     }
 
-    return nullptr;
+    for (int i = 0; i < m_nodes->count(); ++i)
+    {
+        ActionToken* AT = dynamic_cast<ActionToken*>(m_nodes->at(i)->token());
+        if (AT && AT->actionType() == actionType)
+            found.append(m_nodes->at(i));
+    }
+
+    return found;
 }
 
 Node *Table::findNodeByName(const QString &name)
 {    
+    // On 8x8 board the first node with the token is the lowest bit of its bitboard.
+    if (m_bits.isValid() && (name == "start" || name == "prison"))
+    {
+        int square = m_bits.first(name == "start" ? ActionToken::ActionType::START : ActionToken::ActionType::PRISON);
+        return (square >= 0) ? lookForNodeAt(Bitboard::position(square)) : nullptr;
+    }
+
     Node *pretender = nullptr;
     for (int i = 0; i < m_nodes->count(); ++i)
     {
@@ -1674,46 +1932,7 @@ QPoint Table::pixelPosition(const QPoint &gridPosition)
 
 QPoint Table::directionToVector(Player::Direction direction)
 {
-    switch (direction)
-    {
-        case Player::Direction::NO_MOVE:
-            return QPoint(0,0);
-            break;
-
-        case Player::Direction::UP:
-            return QPoint(0,-1);
-            break;
-
-        case Player::Direction::LEFT:
-            return QPoint(-1,0);
-            break;
-
-        case Player::Direction::RIGHT:
-            return QPoint(1,0);
-            break;
-
-        case Player::Direction::DOWN:
-            return QPoint(0,1);
-            break;
-
-        case Player::Direction::LEFT_UP:
-            return QPoint(-1,-1);
-            break;
-
-        case Player::Direction::LEFT_DOWN:
-            return QPoint(-1,1);
-            break;
-
-        case Player::Direction::RIGHT_UP:
-            return QPoint(1,-1);
-            break;
-
-        case Player::Direction::RIGHT_DOWN:
-            return QPoint(1,1);
-            break;
-    }
-
-    return QPoint();
+    return GameTypes::directionToVector(direction);
 }
 
 // ****************************************** SAVING AND LOADING
@@ -1758,6 +1977,9 @@ void Table::loadFrom(const QString &filename)
                 createNode(loaded.gridPosition());
             }
 
+            // Check the loaded map right away, so broken ring is reported before anyone tries to move.
+            compileRing();
+
             showUIItems();
             addUnits();
         }
@@ -1768,148 +1990,46 @@ void Table::loadFrom(const QString &filename)
 
 // *************************************** DESCRIPTION SPECIFICS
 
-QDomDocument Table::domFor(const QString &filename)
-{
-    //    qDebug() << "Loading tokens data: ";
-
-    // 0. Check file existence and format.
-    QFileInfo fi (filename);
-    if (!fi.exists() || fi.completeSuffix() != "xml")
-        return QDomDocument();
-
-    // 1. Read file into xml string.
-    QString xml = "";
-
-    QFile file(filename);
-    if (file.open(QIODevice::ReadOnly))
-    {
-        QTextStream stream(&file);
-        xml = stream.readAll();
-
-        file.close();
-    }
-
-    // 2. Parse XML into DOM model.
-    // Generate DOM document and find nodes with the description of the tokens.
-    QDomDocument document;
-
-    QString error;
-    int error_line;
-
-    bool ok = document.setContent(xml, false, &error, &error_line);    
-    if (ok)
-        qDebug() << "XML file has been parsed well.";
-    else
-        qDebug() << error << " Line: " << error_line;        
-
-    return document;
-}
-
 void Table::loadDescriptions(const QString& filetype, const QString &filename)
 {
-    // 1. Load file into document object model.
-    QDomDocument document = domFor(filename);
-    if (document.isNull())
-    {
-        qDebug() << "Could not parse the file " << filename;
-        return;
-    }
+    // 1. Choose the list, that should be filled, and the type of objects in the file.
+    QList<Description*>* list = nullptr;
+    Description::ObjectType objectType = Description::ObjectType::EMPTY;
 
     if (filetype == "ownership_tokens")
     {
-        // 2. Select all elements with tag "ownership_token".
-        QDomNodeList tokens = document.elementsByTagName("ownership_token");
-        if (tokens.size() == 0)
-            return;
-
-        // 3. Prepare data list. Initialize the pointer or clear old data.
-        if (m_OTDescription)
-            clearOwnershipTokensData();
-
-        // 4. Fill the list with data gathered from the file.
-        // Walk through all the tokens in the list and parse the corresponding node
-        // Store the result as OTD class instance and place it in a list for later use
-        for (int i = 0; i < tokens.size(); ++i)
-        {
-            QDomNode token = tokens.at(i);
-
-            QString index = token.toElement().attribute("index");
-
-            QDomNodeList t = token.childNodes();
-            QString name          = t.at(0).toElement().text();
-            QString description   = t.at(1).toElement().text();
-            QString imagePath     = t.at(2).toElement().text();
-            QString buyingCost    = t.at(3).toElement().text();
-            QString basicIncome   = t.at(4).toElement().text();
-            QString upgradeCost   = t.at(5).toElement().text();
-            QString upgradeLevel  = t.at(6).toElement().text();
-            QString upgradeIncome = t.at(7).toElement().text();
-
-            m_OTDescription->append(new Description(index.toInt(), name, description, imagePath, buyingCost, basicIncome, upgradeCost, upgradeLevel, upgradeIncome));
-
-//            qDebug() << QString("%1. %2: %3. Image: %4. Buy for: %5. Income: %6. Upgrade: cost %7, level %8, income %9.")
-//                        .arg(index).arg(name).arg(description).arg(imagePath).arg(buyingCost).arg(basicIncome).arg(upgradeCost).arg(upgradeLevel).arg(upgradeIncome);
-        }
+        list = m_OTDescription;
+        objectType = Description::ObjectType::OWNERSHIP_TOKEN;
     }
-
-    if (filetype == "action_tokens")
+    else if (filetype == "action_tokens")
     {
-        // 2. Select all elements with tag "action_token".
-        QDomNodeList tokens = document.elementsByTagName("action_token");
-        if (tokens.size() == 0)
-            return;
-
-        // 3. Prepare data list. Initialize the pointer or clear old data.
-        if (m_ATDescription)
-            clearActionTokensData();
-
-        // 4. Fill the list with data gathered from the file.
-        // Walk through all the tokens in the list and parse the corresponding node
-        // Store the result as OTD class instance and place it in a list for later use
-        for (int i = 0; i < tokens.size(); ++i)
-        {
-            QDomNode token = tokens.at(i);
-            QDomNodeList t = token.childNodes();
-
-            QString index = token.toElement().attribute("index");
-            QString type = t.at(0).toElement().text();
-            QString name = t.at(1).toElement().text();
-            QString description = t.at(2).toElement().text();
-            QString imagePath = t.at(3).toElement().text();
-
-            m_ATDescription->append(new Description(index.toInt(), Description::ObjectType::ACTION_TOKEN, type, name, description, imagePath));
-
-//            qDebug() << QString("%1. %2 - %3 (%4)").arg(index.toInt()).arg(name).arg(description).arg(imagePath);
-        }
+        list = m_ATDescription;
+        objectType = Description::ObjectType::ACTION_TOKEN;
     }
-
-    if (filetype == "cards")
+    else if (filetype == "cards")
     {
-        // 2. Select all elements with tag "card".
-        QDomNodeList cards = document.elementsByTagName("card");
-        if (cards.size() == 0)
-            return;
-
-        // 3. Prepare list.
-        if (m_CDescription)
-            clearCardsData();
-
-        // 4. Fill the list.
-        for (int i = 0; i < cards.size(); ++i)
-        {
-            QDomNode card = cards.at(i);
-            QDomNodeList c = card.childNodes();
+        list = m_CDescription;
+        objectType = Description::ObjectType::CARD;
+    }
 
-            QString index = card.toElement().attribute("index");
-            QString type = c.at(0).toElement().text();
-            QString name = c.at(1).toElement().text();
-            QString description = c.at(2).toElement().text();
-            QString imagePath = c.at(3).toElement().text();
+    if (list == nullptr)
+        return;
 
-            m_CDescription->append(new Description(index.toInt(), Description::ObjectType::CARD, type, name, description, imagePath));
-        }
+    // 2. Parse the file. Old data is kept, if there is nothing to replace it with.
+    QList<Description*> descriptions = CatalogLoader::load(objectType, filename);
+    if (descriptions.isEmpty())
+        return;
 
+    // 3. Replace old data with the descriptions gathered from the file.
+    switch (objectType)
+    {
+        case Description::ObjectType::OWNERSHIP_TOKEN: clearOwnershipTokensData(); break;
+        case Description::ObjectType::ACTION_TOKEN:    clearActionTokensData();    break;
+        case Description::ObjectType::CARD:            clearCardsData();           break;
+        case Description::ObjectType::EMPTY:                                       break;
     }
+
+    list->append(descriptions);
 }
 
 void Table::makeTokenFromDescription(const QPoint &gridPosition, const TokenType& tokenType, int index)
@@ -1935,21 +2055,19 @@ void Table::makeTokenFromDescription(const QPoint &gridPosition, const TokenType
                 return;
             }
 
-            if (index < 0 || index > m_ATDescription->count())
+            if (index < 0 || index >= m_ATDescription->count())
             {
                 qDebug() << "Index should be in range [0; count of elements in tokens data list].";
                 return;
             }
 
-            // 1. Get token description data from loaded xml.
-            Description* d = m_ATDescription->at(index);
-
-            // 2. Create new token using these pieces of information.
-            ActionToken *token = new ActionToken(d);
+            // 1. Copy the prototype of the token made from description data.
+            ActionToken *token = ATFor(index);
             token->setRect(node->rect().adjusted(10, 10, -10, -10));
 
-            // 3. Set new ownership token to the node.
+            // 2. Set new ownership token to the node.
             node->setToken(token);
+            indexToken(node);
         }
         break;
 
@@ -1964,22 +2082,19 @@ void Table::makeTokenFromDescription(const QPoint &gridPosition, const TokenType
                 return;
             }
 
-            if (index < 0 || index > m_OTDescription->count())
+            if (index < 0 || index >= m_OTDescription->count())
             {
                 qDebug() << "Index should be in range [0; count of elements in tokens data list].";
                 return;
             }
 
-            // 1. Get token description data from loaded xml.
-            Description* d = m_OTDescription->at(index);
-
-            // 2. Create new token using these pieces of information.
-            OwnershipToken *token = new OwnershipToken(d);
+            // 1. Copy the prototype of the token made from description data.
+            OwnershipToken *token = OTFor(index);
             token->setRect(node->rect().adjusted(10, 10, -10, -10));
 
-            // 3. Set new ownership token to the node.
+            // 2. Set new ownership token to the node.
             node->setToken(token);
-
+            indexToken(node);
         }
         break;
 
@@ -1988,6 +2103,12 @@ void Table::makeTokenFromDescription(const QPoint &gridPosition, const TokenType
 
 void Table::makeCardFromDescription(const Deck::DeckType &deckType, int index)
 {
+    if (!m_CDescription || index < 0 || index >= m_CDescription->count())
+    {
+        qDebug() << "Index should be in range [0; count of elements in cards data list].";
+        return;
+    }
+
     if (deckType == Deck::DeckType::POSITIVE)
         m_cardsP->add(new Card(m_CDescription->at(index)));
 
@@ -1999,20 +2120,25 @@ ActionToken *Table::ATFor(int index)
 {
     Q_ASSERT_X(index >= 0 && index < m_ATDescription->count(), "Table::actionTokenFor", "Index should be in range of AT descriptions list.");
 
-    ActionToken* actionToken = new ActionToken(m_ATDescription->at(index));
-    qDebug() << "Generated AT using description index " << index << ". Image: " + actionToken->imagePath();
+    // Prototype is made once per description, everything else copies it.
+    m_ATPrototypes.resize(m_ATDescription->count());
+    ActionToken*& prototype = m_ATPrototypes[index];
+    if (prototype == nullptr)
+        prototype = new ActionToken(m_ATDescription->at(index));
 
-    return actionToken;
+    return new ActionToken(*prototype);
 }
 
 OwnershipToken *Table::OTFor(int index)
 {
     Q_ASSERT_X(index >= 0 && index < m_OTDescription->count(), "Table::ownershipTokenFor", "Index should be in range of OT descriptions list.");
 
-    OwnershipToken* ownershipToken = new OwnershipToken(m_OTDescription->at(index));
-    qDebug() << "Generated OT using description index " << index << ". Image: " + ownershipToken->imagePath();
+    m_OTPrototypes.resize(m_OTDescription->count());
+    OwnershipToken*& prototype = m_OTPrototypes[index];
+    if (prototype == nullptr)
+        prototype = new OwnershipToken(m_OTDescription->at(index));
 
-    return ownershipToken;
+    return new OwnershipToken(*prototype);
 }
 
 Card *Table::CFor(int index)
@@ -2031,26 +2157,35 @@ void Table::fillNodesWithRandomTokens()
 {
     // Testing method to check behaviour of tokens
 
-    // Check the existence of nodes and descriptions of tokens.
+    // Check the existence of nodes and descriptions of tokens, missing catalog leaves the nodes empty.
     if (!m_nodes)
+    {
         qDebug() << "List of nodes have not been initialized yet.";
+        return;
+    }
 
-    if (!m_ATDescription)
+    if (!m_ATDescription || m_ATDescription->isEmpty())
+    {
         qDebug() << "List of action tokens descriptions have not been initialized yet.";
+        return;
+    }
 
-    if (!m_OTDescription)
+    if (!m_OTDescription || m_OTDescription->isEmpty())
+    {
         qDebug() << "List of ownership tokens descriptions have not been initialized yet.";
+        return;
+    }
 
     // Fill the nodes with random tokens.
     for (int i = 0; i < m_nodes->count(); ++i)
     {
         QPoint position = m_nodes->at(i)->gridPosition();
 
-        int r = 1; // rand() % 2;
+        int r = 1; // m_random.index(GameRandom::Stream::SETUP, 2);
         if (r == 0)
-            makeTokenFromDescription(position, TokenType::OWNERSHIP, rand() % m_OTDescription->count());
+            makeTokenFromDescription(position, TokenType::OWNERSHIP, m_random.index(GameRandom::Stream::SETUP, m_OTDescription->count()));
         else
-            makeTokenFromDescription(position, TokenType::ACTION, (rand()%6 == 1) ? 6 : 4 + rand()%2); // rand() % m_ATDescription->count()); // rand() % m_actionTokensData->count()); // 2 + rand() % 2);
+            makeTokenFromDescription(position, TokenType::ACTION, (m_random.index(GameRandom::Stream::SETUP, 6) == 1) ? 6 : m_random.bounded(GameRandom::Stream::SETUP, 4, 5));
     }
 }
 
@@ -2058,15 +2193,18 @@ void Table::fillDecksWithRandomCards()
 {
     // Testing method to check behaviour of cards
 
-    // Check existence of the descriptions and decks.
-    if (!m_CDescription)
+    // Check existence of the descriptions and decks, missing catalog leaves the decks empty.
+    if (!m_CDescription || m_CDescription->isEmpty())
+    {
         qDebug() << "Cards descriptions have not been loaded yet";
+        return;
+    }
 
-    if (!m_cardsP)
-        qDebug() << "There is no deck of cards with positive bonuses yet.";
-
-    if (!m_cardsN)
-        qDebug() << "There is no deck of cards with negative bonuses yet.";
+    if (!m_cardsP || !m_cardsN)
+    {
+        qDebug() << "There are no decks of cards yet.";
+        return;
+    }
 
     // Fill the decks with random cards.
     for (int i = 0; i < m_cardsP->maxSize(); ++i)        
@@ -2076,7 +2214,7 @@ void Table::fillDecksWithRandomCards()
         makeCardFromDescription(Deck::DeckType::NEGATIVE, 8); // really random number :) // 7 + rand() % 7); // indexes for 7 to 13
 }
 
-void Table::fillHandsWithRandomTokens()
+void Table::fillHandsWithRandomTokens(int count)
 {
     // Testing method to fill the hands of active players with some random ownership tokens.
 
@@ -2095,7 +2233,6 @@ void Table::fillHandsWithRandomTokens()
     }
 
     // 3. Add {count} random OT to each of the players.
-    int count = 5;
     for (int i = 0; i < m_units->count(); ++i)
     {
         Player* p = m_units->at(i);
@@ -2104,8 +2241,8 @@ void Table::fillHandsWithRandomTokens()
             int index;
             for (int ot = 0; ot < count; ++ot)
             {
-                index = rand() % m_OTDescription->count();
-                p->hand()->addToken(new OwnershipToken(m_OTDescription->at(index)));
+                index = m_random.index(GameRandom::Stream::SETUP, m_OTDescription->count());
+                p->hand()->addToken(OTFor(index));
             }
         }
         else
@@ -2116,7 +2253,7 @@ void Table::fillHandsWithRandomTokens()
 
 Node *Table::randomNode()
 {
-    int idx = rand() % m_nodes->count();
+    int idx = m_random.index(GameRandom::Stream::SETUP, m_nodes->count());
 
     return m_nodes->at(idx);
 }
@@ -2140,7 +2277,7 @@ Player *Table::randomOpponent()
 
     qDebug() << QString("There are %1 opponents").arg(opponents.count());
 
-    Player* opponent = opponents.at(rand() % opponents.count());
+    Player* opponent = opponents.isEmpty() ? nullptr : opponents.at(m_random.index(GameRandom::Stream::CARDS, opponents.count()));
     if (opponent == nullptr)
         qDebug() << "There is only one player exists.";
 
@@ -2168,91 +2305,176 @@ void Table::startMovement (Player* player)
         return;
     }
 
-    m_movingPlayer = player;
+    // Movements, that are started by the nodes the unit ended on, are chained, so their count per turn is limited.
+    if (m_chainedMovements >= MAX_CHAINED_MOVEMENTS)
+    {
+        qDebug() << "Too many movements in one turn, this one is skipped.";
+        return;
+    }
+    ++m_chainedMovements;
+
+    // The unit walks in the move phase and the node it ended on is resolved in the next one.
+    // Animated movement makes one step per tick, without animation the whole movement is resolved at once.
+    int steps = m_stepsLeft;
+    m_scheduler.schedule(TurnScheduler::Phase::MOVE, [this, player, steps, started = false]() mutable
+    {
+        if (!started)
+        {
+            started = true;
+            m_movingPlayer = player;
+            m_stepsLeft = steps;
+        }
+
+        if (m_scheduler.mode() == TurnScheduler::Mode::SYNCHRONOUS)
+        {
+            moveInstantly(m_movingPlayer, m_stepsLeft);
+            return true;
+        }
+
+        return stepMovement();
+    }, STEP_INTERVAL / m_movementSpeed);
 
-    // Start movement timer.
-    connect(&m_autoMovementTimer, SIGNAL(timeout()), this, SLOT(autoMovement()));
-    m_autoMovementTimer.start(150/m_movementSpeed);
+    m_scheduler.schedule(TurnScheduler::Phase::RESOLVE_NODE, [this]()
+    {
+        finishMovement();
+        return true;
+    });
 }
 
-void Table::autoMovement()
+bool Table::stepMovement()
 {
-    // In cas moving player is not current (when control cards are activated, for example), we'll use another pointer to handle these situations.
-    qDebug() << "Current player exists: " << (m_movingPlayer != nullptr) << ". Name: " << m_movingPlayer->name();
+    // In case moving player is not current (when control cards are activated, for example), we'll use another pointer to handle these situations.
+    QPoint previous = m_movingPlayer->gridPosition();
+    stepAuto(m_movingPlayer);
 
-    if (m_movingPlayer)
-    {        
-        stepAuto(m_movingPlayer);
+    // The unit, that can't go further, ends its movement where it stands.
+    if (m_movingPlayer->gridPosition() == previous)
+    {
+        m_stepsLeft = 0;
+        return true;
+    }
 
-        Token* token = getNodeAt(m_movingPlayer->gridPosition(),true)->token();
-        ActionToken* AT = dynamic_cast<ActionToken*>(token);
-        OwnershipToken* OT = dynamic_cast<OwnershipToken*>(token);
+    Token* token = getNodeAt(m_movingPlayer->gridPosition(),true)->token();
+    ActionToken* AT = dynamic_cast<ActionToken*>(token);
 
-        // give rewards for passed circle even if it is not the end node for current turn
-        if (AT && AT->actionType() == ActionToken::ActionType::START)
-            action(AT->actionType());
+    // give rewards for passed circle even if it is not the end node for current turn
+    if (AT && AT->actionType() == ActionToken::ActionType::START)
+        passStart(m_movingPlayer);
 
-        if (m_stepsLeft == 0)
-        {
-            // Stop movement timer.
-            m_autoMovementTimer.stop();
-            disconnect(&m_autoMovementTimer, SIGNAL(timeout()), this, SLOT(autoMovement()));
+    return (m_stepsLeft == 0);
+}
 
-            m_currentPlayer = m_movingPlayer;
-            m_movingPlayer = nullptr;
+void Table::finishMovement()
+{
+    Token* token = getNodeAt(m_movingPlayer->gridPosition(),true)->token();
+    ActionToken* AT = dynamic_cast<ActionToken*>(token);
+    OwnershipToken* OT = dynamic_cast<OwnershipToken*>(token);
 
-            // Default the movement constraint and speed.
-            if (m_constraintCurrent != m_constraintDefault)
-            {
-                m_constraintCurrent = m_constraintDefault;
+    m_currentPlayer = m_movingPlayer;
+    m_movingPlayer = nullptr;
 
-                Player::Direction nDir = Player::Direction::NO_MOVE;
-                Player::Direction cDir = m_currentPlayer->direction();
+    // Default the movement constraint and speed.
+    if (m_constraintCurrent != m_constraintDefault)
+    {
+        m_constraintCurrent = m_constraintDefault;
 
-                if (cDir == Player::Direction::UP) nDir = Player::Direction::DOWN;
-                if (cDir == Player::Direction::DOWN) nDir = Player::Direction::UP;
-                if (cDir == Player::Direction::LEFT) nDir = Player::Direction::RIGHT;
-                if (cDir == Player::Direction::RIGHT) nDir = Player::Direction::LEFT;
+        Player::Direction nDir = Player::Direction::NO_MOVE;
+        Player::Direction cDir = m_currentPlayer->direction();
 
-                m_currentPlayer->setDirection(nDir);
-            }
+        if (cDir == Player::Direction::UP) nDir = Player::Direction::DOWN;
+        if (cDir == Player::Direction::DOWN) nDir = Player::Direction::UP;
+        if (cDir == Player::Direction::LEFT) nDir = Player::Direction::RIGHT;
+        if (cDir == Player::Direction::RIGHT) nDir = Player::Direction::LEFT;
 
-            m_movementSpeed = 1;
+        m_currentPlayer->setDirection(nDir);
+    }
 
-            // Check where the player ended his turn. Here various actions based on this circumstance may be activated.
-            qDebug() << "Player " << m_currentPlayer->name() << " ended his turn on token: " << (AT ? AT->name() : OT ? OT->name() : "empty") << ".";
-            if (AT) action(AT->actionType());
-            if (OT) ;
+    m_movementSpeed = 1;
 
-            // Update details item.
-            if (m_currentPlayer)
-                qDebug() << "Current player finished his turn, but the pointer to him is still relevant.";
+    // Check where the player ended his turn. Here various actions based on this circumstance may be activated.
+    // Start node has been paid already, when unit passed it.
+    qDebug() << "Player " << m_currentPlayer->name() << " ended his turn on token: " << (AT ? AT->name() : OT ? OT->name() : "empty") << ".";
+    if (AT && AT->actionType() != ActionToken::ActionType::START) action(AT->actionType());
+    if (OT) ;
 
-            m_details->show();
-            m_details->showButtons();
-            m_details->setPlayer(m_currentPlayer);
-            m_details->setToken(OT);
-            m_details->update();
-        }
+    // Update details item.
+    if (m_currentPlayer)
+        qDebug() << "Current player finished his turn, but the pointer to him is still relevant.";
+
+    if (m_renderingSuspended > 0)
+    {
+        m_details->setPlayer(m_currentPlayer);
+        m_details->setToken(OT);
+        m_detailsDirty = true;
+        return;
     }
+
+    m_details->show();
+    m_details->showButtons();
+    m_details->setPlayer(m_currentPlayer);
+    m_details->setToken(OT);
+    m_repaint->invalidate(m_details);
 }
 
-void Table::autoMovementTogether()
+void Table::moveInstantly(Player *player, int steps)
 {
-    qDebug() << "here";
+    if (m_ringDirty)
+        compileRing();
 
-    for (int i = 0; i < m_units->count(); ++i)
+    // On the closed ring the landing node and count of passed start nodes are known from ring position and steps.
+    int from = m_ring.indexOf(player->gridPosition());
+    if (from >= 0 && m_constraintCurrent != Constraint::UNCONSTRAINED)
     {
-        Player* player = m_units->at(i);
-        stepAuto(player);
-
-        if (m_stepsLeft == 0)
+        int crossings = 0;
+        QList<Node*> starts = findNodesByType(ActionToken::ActionType::START);
+        for (int i = 0; i < starts.count(); ++i)
+            crossings += m_ring.passes(from, steps, m_constraintCurrent, m_ring.indexOf(starts.at(i)->gridPosition()));
+
+        int to = m_ring.advance(from, steps, m_constraintCurrent);
+        player->setDirection(m_ring.direction(m_ring.advance(to, -1, m_constraintCurrent), m_constraintCurrent));
+        placeUnit(player, lookForNodeAt(m_ring.at(to)));
+
+        // Wage and returns are paid once per each passed start node.
+        for (int i = 0; i < crossings; ++i)
+            passStart(player);
+    }
+    else
+    {
+        // Maps, that are not closed rings, are walked step by step, but still without waiting for the timer.
+        m_stepsLeft = steps;
+        while (m_stepsLeft > 0)
         {
-            // Stop
-            m_autoMovementTogetherTimer.stop();
-            disconnect(&m_autoMovementTogetherTimer, SIGNAL(timeout()), this, SLOT(autoMovementTogether()));
+            QPoint previous = player->gridPosition();
+            stepAuto(player);
+            if (player->gridPosition() == previous)
+                break;
+
+            ActionToken* AT = dynamic_cast<ActionToken*>(lookForNodeAt(player->gridPosition())->token());
+            if (AT && AT->actionType() == ActionToken::ActionType::START)
+                passStart(player);
         }
     }
+
+    m_stepsLeft = 0;
+    updateUI();
+}
+
+void Table::passStart(Player *player)
+{
+    player->circle();                                   // passed circles stats
+    player->hand()->receive(GameRules::START_WAGE);     // wage per passed circle
+
+    int returns = player->hand()->returns();            // returns from the ownings
+    if (returns > 0)
+        player->hand()->receive(returns);
+
+    emit m_events.goldChanged(player);
+}
+
+void Table::setInstantMovement(bool instant)
+{
+    m_instantMovement = instant;
+    m_scheduler.setMode(instant ? TurnScheduler::Mode::SYNCHRONOUS : TurnScheduler::Mode::ANIMATED);
 }
 
 void Table::setMovementConstraint(Constraint constraint)
@@ -2266,6 +2488,18 @@ void Table::setMovementSpeed(int value)
         m_movementSpeed = value;
 }
 
+void Table::compileRing()
+{
+    QVector<QPoint> gridPositions;
+    for (int i = 0; i < m_nodes->count(); ++i)
+        gridPositions.append(m_nodes->at(i)->gridPosition());
+
+    if (!m_ring.compile(gridPositions) && l_history)
+        l_history->addMessage(QString("Units can't walk around this map. %1").arg(m_ring.error()));
+
+    m_ringDirty = false;
+}
+
 void Table::stepAuto(Player* player)
 {
     QPoint pos = player->gridPosition();
@@ -2275,67 +2509,29 @@ void Table::stepAuto(Player* player)
     if (dir == Player::Direction::NO_MOVE)
         qDebug() << "There isn't any movements.";
 
-    // What if...
-    // 1. Separate corners based of awailable ways.
-    // 2. Separate horizontals and verticals based on what. Class instance to hold the line? Grid position checking?
-    // Or some sort of *edges* between nodes? Maybe edges, maybe not, who knows.
-
-    // Lets say, we have a map like this:
-    // *****R***
-    // *       D
-    // **  **L**
-    //  U  D
-    // **  *R*
-    // *     D
-    // *****L*
-
-    // There are four types of corners.
-    // Player can approach them for two different sides.
-    // That means, he has direction in which he moves, and some type of corner. And needs to know, which direction to take next.
-
-    // Meaning of bits in the neighbours bit array: L-R-U-D-LU-LD-RU-RD
-    QBitArray neighbours = checkNeighbours(pixelPosition(pos));
-    bool l = neighbours.at(0), r = neighbours.at(1), u = neighbours.at(2), d = neighbours.at(3);
-
-    // Lets try to change priority direction on corners
-    bool ulC = !u &&  r &&  d && !l;
-    bool urC = !u && !r &&  d &&  l;
-    bool lrC =  u && !r && !d &&  l;
-    bool llC =  u &&  r && !d && !l;
+    if (m_constraintCurrent == Constraint::UNCONSTRAINED)
+        return;
 
-    qDebug() << QString("UL: %1. UR: %2. LR: %3. LL: %4").arg(ulC).arg(urC).arg(lrC).arg(llC);
+    // Nodes are compiled into the ring once after the map was changed.
+    // Each step is then just the move to the next node of the ring for current constraint.
+    if (m_ringDirty)
+        compileRing();
 
-    // For clockwise movement, units move in sequence UPPER->RIGHT->BOTTOM->LEFT line.
-    if (m_constraintCurrent == Constraint::CLOCKWISE)
+    int index = m_ring.indexOf(pos);
+    if (index >= 0)
     {
-        // upper left corner // upper right corner // lower left corner // lower right corner
-        // ** (left->down)   // ** (right->down)   // *  (left->up)     //  * (right->up)
-        // *  (up->right)    //  * (up->left)      // ** (down->right)  // ** (down->left)
-
-        if (ulC) player->setDirection(player->direction() == Player::Direction::LEFT  ? Player::Direction::DOWN : Player::Direction::RIGHT);
-        if (urC) player->setDirection(player->direction() == Player::Direction::RIGHT ? Player::Direction::DOWN : Player::Direction::LEFT);
-        if (lrC) player->setDirection(player->direction() == Player::Direction::RIGHT ? Player::Direction::UP   : Player::Direction::LEFT);
-        if (llC) player->setDirection(player->direction() == Player::Direction::LEFT  ? Player::Direction::UP   : Player::Direction::RIGHT);
-
+        player->setDirection(m_ring.direction(index, m_constraintCurrent));
         step (player, player->direction());
-
+        return;
     }
 
-    // For counter clockwise movement, units move in sequence LEFT->BOTTOM->RIGHT->UPPER line.
-    if (m_constraintCurrent == Constraint::COUNTER_CLOCKWISE)
-    {
-        // upper left corner // upper right corner // lower left corner // lower right corner
-        // ** (left->down)   // ** (right->down)   // *  (left->up)     //  * (right->up)
-        // *  (up->right)    //  * (up->left)      // ** (down->right)  // ** (down->left)
-
-        // As for counter clockwise movement, the affect of corner positions on next direction is a bit different.
-        if (ulC) player->setDirection(player->direction() == Player::Direction::UP ? Player::Direction::RIGHT : Player::Direction::DOWN);
-        if (urC) player->setDirection(player->direction() == Player::Direction::RIGHT ? Player::Direction::DOWN : Player::Direction::LEFT);
-        if (lrC) player->setDirection(player->direction() == Player::Direction::DOWN ? Player::Direction::LEFT : Player::Direction::UP);
-        if (llC) player->setDirection(player->direction() == Player::Direction::LEFT ? Player::Direction::UP : Player::Direction::RIGHT);
+    // If the map is not a closed ring, direction is chosen on corners by the neighbours of the node.
+    // Meaning of bits in the neighbours bit array: L-R-U-D-LU-LD-RU-RD
+    QBitArray neighbours = checkNeighbours(pixelPosition(pos));
+    bool l = neighbours.at(0), r = neighbours.at(1), u = neighbours.at(2), d = neighbours.at(3);
 
-        step (player, player->direction());
-    }
+    player->setDirection(GameRules::nextDirection(l, r, u, d, player->direction(), m_constraintCurrent));
+    step (player, player->direction());
 }
 
 void Table::step(Player *unit, Player::Direction direction)
@@ -2346,25 +2542,61 @@ void Table::step(Player *unit, Player::Direction direction)
     qDebug() << " unit position: " << unit->gridPosition();
     qDebug() << "check position: " << unit->gridPosition() + directionToVector(direction);
 
-    QPoint prevPosition = unit->gridPosition();
     QPoint currPosition = unit->gridPosition() + directionToVector(direction);
 
     bool moveIsAvailable = (getNodeAt(currPosition, true) != nullptr);
     if (moveIsAvailable)
     {
-        Node* prev = getNodeAt(prevPosition, true);
-        Node* curr = getNodeAt(currPosition, true);
+        placeUnit(unit, getNodeAt(currPosition, true));
+
+        --m_stepsLeft;
 
+        updateUI();
+    }
+}
+
+void Table::placeUnit(Player *unit, Node *node)
+{
+    QPoint from = unit->gridPosition();
+    Node* prev = getNodeAt(from, true);
+    if (prev)
         prev->setActive(false);
-        curr->setActive(true);
 
-        unit->setGridPosition(curr->gridPosition());
-        unit->setRect(curr->rect());
+    node->setActive(true);
 
-        --m_stepsLeft;
+    // The place, where the unit is seen now, including the rest of the glide, that may still be running.
+    QPointF visible = unit->rect().topLeft() + unit->pos();
 
-        updateUI();
+    unit->setGridPosition(node->gridPosition());
+    unit->setRect(node->rect());
+
+    // Logical position changes at once, only the picture of the unit follows it smoothly.
+    if (m_instantMovement || m_renderingSuspended > 0)
+    {
+        AnimationClock::instance().stop(unit);
+        unit->setPos(0, 0);
+    }
+    else
+        glideUnit(unit, visible);
+
+    emit m_events.unitMoved(unit, from, node->gridPosition());
+}
+
+void Table::glideUnit(Player *unit, const QPointF &from)
+{
+    QPointF offset = from - unit->rect().topLeft();
+    if (offset.isNull())
+    {
+        AnimationClock::instance().stop(unit);
+        return;
     }
+
+    // All the moving units share the clock, so their count doesn't change the count of timer wakeups.
+    unit->setPos(offset);
+    AnimationClock::instance().animate(unit, STEP_INTERVAL / m_movementSpeed, [unit, offset](qreal progress)
+    {
+        unit->setPos(offset * (1 - progress));
+    });
 }
 
 void Table::nextPlayer()
@@ -2385,7 +2617,68 @@ int  Table::dropDie(int low, int high)
 {
     Q_ASSERT_X(low >= 0 && high <= 100, "Table::dropDie", "low should be greater than 0, high should be less than 100");
 
-    return (low + rand() % high);
+    return GameRules::dropDie(m_random, low, high);
+}
+
+int Table::advanceTurns(int turns, const std::function<bool()> &condition)
+{
+    // Turns can't be made, while the previous one is not over yet (some unit is still walking around the board, for example).
+    if (!m_units || m_units->count() < 2 || !m_scheduler.isIdle())
+        return 0;
+
+    // Synchronous scheduler completes the whole turn before scheduleTurn returns.
+    bool instant = m_instantMovement;
+    setInstantMovement(true);
+    suspendRendering();
+
+    int made = 0;
+    while (made < turns)
+    {
+        scheduleTurn();
+        ++made;
+
+        if (condition && condition())
+            break;
+    }
+
+    l_history->addMessage(QString("%1 turns have been made at once.").arg(made));
+    resumeRendering();
+    setInstantMovement(instant);
+
+    return made;
+}
+
+void Table::scheduleTurn()
+{
+    // The turn is the pipeline: roll the die, move the unit and resolve the node it ended on (see startMovement), end the turn.
+    m_scheduler.schedule(TurnScheduler::Phase::ROLL, [this]()
+    {
+        m_chainedMovements = 0;
+        turn();
+        startMovement(m_currentPlayer);
+        return true;
+    });
+
+    m_scheduler.schedule(TurnScheduler::Phase::END_TURN, [this]()
+    {
+        updateUI();
+        return true;
+    });
+}
+
+void Table::useCard(Card *card)
+{
+    // Card, that is used while the turn is not over, waits for the end of it.
+    // It may be chosen once more meanwhile, so the card is activated only if it is still in hand.
+    m_scheduler.schedule(TurnScheduler::Phase::RESOLVE_CARD, [this, card]()
+    {
+        if (m_currentPlayer && m_currentPlayer->hand()->hasCard(card))
+        {
+            m_chainedMovements = 0;
+            activate(card);
+        }
+        return true;
+    });
 }
 
 void Table::turn()
@@ -2424,7 +2717,7 @@ void Table::viewMousePositionChanged (const QPoint& mousePosition)
             menu->setState(Menu::State::BUTTON_HOVER);
 
             button->setColor(UIElement::Element::FILL, QColor("#fac404"));
-            button->setFont(QFont("Truetypewriter PolyglOTT", 13));
+            button->setFont(PaintResources::Font::MENU_HOVER);
             button->setText(QString(">>> %1 <<<").arg(button->defaultText()));
         }
         else
@@ -2444,6 +2737,11 @@ void Table::onEditMode()
         m_mode = Mode::PLAY;
 }
 
+void Table::onSkipAnimation()
+{
+    setInstantMovement(pb_skipAnimation->isChecked());
+}
+
 void Table::onSaveMap()
 {
     QString filename = QFileDialog::getSaveFileName(nullptr, "Choose map file to save to", QString(), "*.tm");
@@ -2460,11 +2758,15 @@ void Table::onLoadMap()
 
 void Table::onDefaults()
 {
+    // Tasks of the turn, that is not over yet, and marked regions refer to the units, that are about to be removed.
+    m_scheduler.clear();
+    m_repaint->clear();
+
     clearNodes();
     clearDecks();
     clearUnits();
 
-    loadFrom("not_round.tm");
+    loadFrom(AssetPack::instance().fileFor(m_files.map));
     if (m_units->isEmpty())
         addUnits();
 
@@ -2475,6 +2777,9 @@ void Table::onDefaults()
 
 void Table::onTurn()
 {
-    turn();
-    startMovement(m_currentPlayer);
+    // Next turn starts only after the previous one is over.
+    if (!m_units || m_units->count() < 2 || !m_scheduler.isIdle())
+        return;
+
+    scheduleTurn();
 }
@@ -10,14 +10,18 @@
 #include <QGridLayout>
 
 #include <QBitArray>
-#include <QTimer>
 #include <QList>
 
-#include <QtXml/QDomDocument>
-#include <QtXml/QDomNodeList>
-#include <QtXml/QDomElement>
+#include <functional>
 
-#include "helper/description.h"
+#include "core/description.h"
+#include "core/catalogloader.h"
+#include "core/gamerules.h"
+#include "core/gridindex.h"
+#include "core/boardring.h"
+#include "core/bitboard.h"
+#include "core/gamerandom.h"
+#include "core/turnscheduler.h"
 #include "nodes/node.h"
 #include "nodes/tokens/actiontoken.h"
 #include "nodes/tokens/ownershiptoken.h"
@@ -25,6 +29,9 @@
 #include "player/player.h"
 
 #include "ui/historylabel.h"
+#include "ui/gameevents.h"
+#include "ui/repaintqueue.h"
+#include "ui/boardlayer.h"
 #include "ui/uielement.h"
 #include "ui/details.h"
 #include "ui/menu.h"
@@ -34,7 +41,7 @@ class Table : public QWidget
     Q_OBJECT
 
 public:
-    enum class Constraint {CLOCKWISE, COUNTER_CLOCKWISE, UNCONSTRAINED};
+    using Constraint = GameTypes::Constraint;
     enum class TokenType  {ACTION, OWNERSHIP};
     enum class Mode       {MENU, PLAY, EDIT};
 
@@ -50,6 +57,41 @@ public:
     void mousePressEvent(QMouseEvent *event) override;
     void mouseDoubleClickEvent(QMouseEvent *event) override;    
 
+    // Random:
+    // * setSeed fixes the seed of the random generator for the next games, so they can be replayed exactly.
+    //   Without it each new game takes random seed, that is written to the history.
+    void setSeed (quint64 seed);
+
+    // Files:
+    // * setFiles changes the map and catalogs, that are loaded by the next game and by defaults button.
+    //   Each of them is asset ID, resolved in data directory of AssetPack ("at/at.xml" is data/tokens/at/at.xml), or any other path.
+    struct Files
+    {
+        QString map             = "maps/not_round.tm";
+        QString actionTokens    = "at/at.xml";
+        QString ownershipTokens = "ot/ot.xml";
+        QString cards           = "cards/cards.xml";
+    };
+
+    void setFiles (const Files& files);
+
+    // Fast-forward:
+    // * advanceTurns makes up to specific count of turns at once, without animation and with rendering suspended,
+    //   returns the count of made turns. If condition is set, it is checked after each turn and stops the play, when it is true.
+    //   Nothing is made while some unit is still animated. F key makes FAST_FORWARD_TURNS turns this way.
+    int advanceTurns (int turns, const std::function<bool()>& condition = nullptr);
+
+    // Measurements:
+    // * scheduler returns the pipeline of turn phases, its stats (and summary) are the latency of each phase of played turns.
+    const TurnScheduler& scheduler () const;
+
+    // Benchmark:
+    // * populate starts the new game on the default map and gives each player handTokens more ownership tokens,
+    //   then shows the details of the first player, so the scene has everything, that is drawn during the play;
+    // * scene returns the scene of the table, benchmark renders it offscreen.
+    void populate (int handTokens);
+    QGraphicsScene* scene () const;
+
 private:
     // Editing or playing
     void setMode (const Mode& m_mode);
@@ -60,10 +102,18 @@ private:
     void newGame();
     void quit();
 
+    // - m_random is the generator of the current game, all dice, cards and random fillings take their values from it;
+    // - m_seed is the seed for the next games, if m_seedFixed is true;
+    // - m_files are the map and catalogs of the next games.
+    GameRandom m_random;
+    quint64    m_seed = 0;
+    bool       m_seedFixed = false;
+    Files      m_files;
+
     // Initialization.
     // These are the methods to:
     // - setup scene and view;
-    // - draw the grid lines for table and hands regions;
+    // - create the static board layer, that draws the grid lines together with nodes;
     // - add objects to the scene;
     // - compose user interface and update it.
     void activateHistory();
@@ -79,6 +129,7 @@ private:
     // objects and collections of objects. Remarkably, used in destructor for cleaning before instance deleting.
     void clearScene();
     void clearNodes();
+    void forgetNode(Node* node);
     void clearDescriptions();
     void clearOwnershipTokensData();
     void clearActionTokensData();
@@ -91,11 +142,10 @@ private:
 
     // Serialization
     // * saveTo and loadFrom methods are used to save and load the generated map;
-    // * loadTokensData and domFor allow fetching the tokens data from outer XML file.
+    // * loadDescriptions fetches the tokens or cards data from outer XML file using CatalogLoader.
     void saveTo (const QString& filename);
     void loadFrom (const QString& filename);    
     void loadDescriptions (const QString& filetype, const QString& filename);
-    QDomDocument domFor  (const QString& filename);
 
     // Checkers
     // * removalIsValid method returns true, if the node may be removed from the scene;
@@ -114,6 +164,7 @@ private:
     Node* getNodeAt (const QPoint& position, bool onGrid);
     Node* lookForNodeAt (const QPoint& gridPosition);
     Node* findNodeByName(const QString& name);
+    QList<Node*> findNodesByType(ActionToken::ActionType actionType);
 
     QBitArray checkNeighbours (const QPoint& pixelPosition);
     bool hasNeighbourNode (const QPoint& pixelPosition, Player::Direction direction);
@@ -141,34 +192,48 @@ private:
     QPoint          m_viewMP;
 
     // Nodes:
-    // * createNode is the factory method to create node at specific grid position and place it on the scene;
-    // * addNode is the helper method to add generated node to the scene, if it is not there yet;
-    // * removeNode is the helper method to remove existing node from the scene, if it is there;
+    // * createNode is the factory method to create node at specific grid position and place it on the board;
+    // * addNode is the helper method to add generated node to the board, if it is not there yet;
+    // * removeNode is the helper method to remove existing node from the board, if it is there;
     // * editNode is the method to make the interaction with editor dialogue possible;
+    // * indexToken updates bitboards and the board layer after the token of the node has been changed;
+    // * invalidateBoard makes the board layer render the nodes again after the map has been changed;
     // - NODE_WIDTH and NODE_HEIGHT are basic values of each nodes' sizes;
     // - NODES_PER_ROW and NODES_PER_COLUMN used to set maximum count of nodes that can be placed on table;
-    // - m_nodes is the storage for all placed nodes, used for interaction with them.
+    // - m_nodes is the storage for all placed nodes, used for interaction with them;
+    // - m_grid is the index of the same nodes by their grid positions, used for constant-time lookups and neighbours checks.
+    //   It is kept in sync by addNode, removeNode and clearNodes;
+    // - m_bits are the bitboards of nodes and their action tokens, used for neighbours checks and special nodes search on 8x8 board;
+    // - m_board is the static layer, that paints grid and nodes from the cached pixmap. Nodes are not the items of the scene.
     Node* createNode  (const QPoint& gridPosition);
     void  addNode (Node* n);
     void  removeNode (Node* n);
     void  editNode (Node* n);
+    void  indexToken (Node* n);
+    void  invalidateBoard ();
 
     const int NODE_WIDTH = 88;
     const int NODE_HEIGHT = 88;
     const int NODES_PER_ROW = 8;
     const int NODES_PER_COLUMN = 8;
     QList<Node*> *m_nodes = nullptr;
+    GridIndex<Node*> m_grid;
+    BoardBits        m_bits;
+    BoardLayer*      m_board = nullptr;
 
     // Tokens:
     // These store the information of all tokens, that are loaded from XML files.
     // May be used by factory methods to create actual tokens and placing them to nodes.
     // * ATFor method creates new action token using description data from the m_ATDescription list item with specific index;
     // * OTFor method creates new ownership token using description data from the m_OTDescription list item with specific index;
+    //   both of them copy the prototype of the description, so new tokens share its name, artwork and prices;
     // * CFor  method creates new card using description data from m_CDescription list with specific index;
     // * addToken creates token of specific tokenType and index, and places it for node at gridPosition;
     // * addCard  creates card  of specific  deckType and index, and places it into corresponding deck;
     // - m_ownershipTokensData is the storage for all description objects, created after loading of ot.xml file;
-    // - m_actionTokensData    is the storage for all description objects, created after loading of at.xml file.    
+    // - m_actionTokensData    is the storage for all description objects, created after loading of at.xml file;
+    // - m_ATPrototypes and m_OTPrototypes are the tokens made from descriptions with the same indexes on the first request,
+    //   they are never placed on the board and are deleted together with their descriptions.
     ActionToken*    ATFor (int index);
     OwnershipToken* OTFor (int index);
     Card*           CFor  (int index);
@@ -179,6 +244,8 @@ private:
     QList<Description*> *m_OTDescription = nullptr;
     QList<Description*> *m_ATDescription = nullptr;
     QList<Description*> *m_CDescription  = nullptr;
+    QVector<ActionToken*>    m_ATPrototypes;
+    QVector<OwnershipToken*> m_OTPrototypes;
 
     // Units:
     // * createUnit is the factory method to create unit at specific grid position and description;
@@ -224,56 +291,101 @@ private:
     // cost and nodes movement based of the graph search algorithms (A*, Dijkstra, Kraskal-Prim etc.), as well
     // as for monopoly-like board games, the movement type can be controlled through Constraint enumeration.
     // * setMovementConstraint method allows to select one of the affordable constraint types;
-    // * startAutoMovement method initializes timer and connects it to the relevant slot, that performs auto movement;
+    // * startMovement schedules the move phase of the unit and the resolve node phase after it;
+    // * stepMovement makes one animated step of the moving unit, returns true, when the movement is complete;
+    // * compileRing method puts the nodes into the ring of movement, it is called after the map was loaded or edited;
     // * stepAuto method makes one step of the current player in an automatic regime;
-    // * action method is called, when player ends his turn on one of the nodes with action tokens;
+    // * action method is called, when player ends his turn on one of the nodes with action tokens,
+    //   activate applies the effect of the card;
+    //   NOTE: effects of tokens and cards (action, activate, passStart) are written twice: here for the scene
+    //   and in core/rulesengine.cpp for the simulator, which doesn't use the table. Change both of them together,
+    //   otherwise simulated balance no longer describes the real game;
     // * step method just makes the movement of unit in a specific direction, if it is allowed;
-    // * turn method passes the turn to next player in a list in a circular way.
+    // * placeUnit puts the unit on specific node and highlights it, glideUnit makes it slide there from its previous place on the animation clock;
+    // * moveInstantly resolves the whole movement at once using the ring, without any timer ticks;
+    // * finishMovement ends the movement of moving unit: defaults the constraint and activates the node it ended on;
+    // * passStart gives the player wage and returns from his companies for passed circle;
+    // * setInstantMovement turns the animation of movement off (for skip animation mode) and on;
+    // * turn method passes the turn to next player in a list in a circular way and drops the die;
+    // * scheduleTurn schedules the phases of the whole turn, useCard schedules the activation of the card.
     // - m_constraint used to allow user to change the constrain type on the fly;
-    // - m_movingTimer used to make the movement of units step by step instead of quick change of the position,
-    //   through connection the slot that makes the steps and checks the count of steps left for current player,
-    //   when there are no steps left, the timer detaches from slot and waits for activation by next player.
+    // - m_ring is the compiled sequence of nodes, so each step knows the next node without checking neighbours,
+    //   m_ringDirty is set when nodes are added or removed and the ring should be compiled again;
+    // - m_scheduler runs the phases of turns and cards one by one: animated, when units walk step by step on its timer,
+    //   or synchronous, when everything is resolved at once;
+    // - m_instantMovement is true, if units should not be animated while moving (scheduler is synchronous then),
+    //   m_chainedMovements counts movements started during one turn or card, they are limited by MAX_CHAINED_MOVEMENTS;
+    // - STEP_INTERVAL is the duration of one animated step in ms at movement speed 1, the unit glides to the next node during it;
     // - m_stepsLeft represents count of steps for current player;
     //   when user clicks turn, the random value from 1 to 6 is generated and set and its value,
     //   random seed ensures it would be different of each running of the application.    
     void setMovementConstraint  (Constraint constraint);
     void setMovementSpeed  (int value);
     void startMovement (Player* player);
+    bool stepMovement  ();
+    void compileRing   ();
     void stepAuto          (Player* player);
     void step (Player* unit, Player::Direction direction);
+    void placeUnit (Player* unit, Node* node);
+    void glideUnit (Player* unit, const QPointF& from);
+    void moveInstantly  (Player* player, int steps);
+    void finishMovement ();
+    void passStart (Player* player);
+    void setInstantMovement (bool instant);
     void turn ();
+    void scheduleTurn ();
+    void useCard (Card* card);
 
     void action   (ActionToken::ActionType actionType);
     void activate (Card* card);
 
     Constraint m_constraintCurrent = Constraint::UNCONSTRAINED;
     Constraint m_constraintDefault = Constraint::COUNTER_CLOCKWISE;
-    QTimer m_autoMovementTimer, m_autoMovementTogetherTimer;
+    BoardRing  m_ring;
+    bool       m_ringDirty = true;
+    TurnScheduler m_scheduler;
     int m_stepsLeft = 0;
+    bool m_instantMovement = false;
+    int  m_chainedMovements = 0;
+    const int MAX_CHAINED_MOVEMENTS = 8;
 
     const int MIN_MOVEMENT_SPEED = 1;
     const int MAX_MOVEMENT_SPEED = 5;
+    const int STEP_INTERVAL = 150;
     int m_movementSpeed = 1;
 
     // UI:
     // * makeUI makes all necessary widgets and items representing UI and composes the view of the app;
-    // * updateUI makes user interface interactable: updates data on different widgets and items;
+    // * updateUI marks user interface as changed, refreshUI actually updates data on different widgets and items once per frame;
+    // * suspendRendering and resumeRendering batch the redrawing between them: view is not repainted, history only stores messages,
+    //   repaint queue and details item only record, that they should be updated. Everything is flushed once on resume;
+    // * subscribeViews connects the views to the game events, so they mark changed regions in repaint queue.
     // Application uses these widgets:
     // - pb_editMode is toggle button to turn to editor mode and vise versa;
     // - pb_saveMap and pb_loadMap are buttons to save the created map into some file and load from it correspondingly;
     // - pb_defaults used for loading of the default map and filling test tokens there, useful for testing purposes;
     // - pb_turn is the button to choose the current player and move his unit on the board;
+    // - pb_skipAnimation is toggle button to resolve movements at once instead of animating them step by step;
     // - l_turn and l_steps are status label showing the current player index and name, as well as left count of steps;
     // - m_layout used for composing the user interface and setting it for this widget.
     // Besides widgets, there are also graphics items that are used as UI objects:
     // - m_currentPlayerStatus represents some sort of shape with text inside.
     // - m_tokenDetails is used to show the detailed description of the token player stands on currently.
+    // Batching:
+    // - m_renderingSuspended counts nested suspensions;
+    // - m_detailsDirty is true, if details item should be shown, when rendering is resumed;
+    // - m_events is the bus of game events (gold, companies, units and cards), rules emit them instead of repainting views;
+    // - m_repaint collects regions and items changed by the events and repaints each of them once per frame.
     void addMenu();
     void addUIItems();
     void addUIWidgets();
     void hideUIItems();
     void showUIItems();
     void updateUI();
+    void refreshUI();
+    void suspendRendering();
+    void resumeRendering();
+    void subscribeViews();
 
     HistoryLabel* l_history  = nullptr;
     QPushButton *pb_editMode = nullptr;
@@ -281,10 +393,17 @@ private:
     QPushButton *pb_loadMap  = nullptr;
     QPushButton *pb_defaults = nullptr;
     QPushButton *pb_turn     = nullptr;
+    QPushButton *pb_skipAnimation = nullptr;
     QLabel      *l_turn      = nullptr;
     QLabel      *l_steps     = nullptr;
     QGridLayout *m_layout    = nullptr;
 
+    int    m_renderingSuspended = 0;
+    const int FAST_FORWARD_TURNS = 10;
+    bool   m_detailsDirty = false;
+    GameEvents    m_events;
+    RepaintQueue* m_repaint = nullptr;
+
     Menu      *m_menu    = nullptr;
     Details   *m_details = nullptr;
     UIElement *m_status  = nullptr;
@@ -298,11 +417,11 @@ private:
     // Testing:
     // - dummyToken returns empty token to fill the node at least with something;
     // - randomNode returns randomly chosen node from the list of available;
-    // - fillRandomTokens fill all the existing nodes with randomly chosen tokens.
+    // - fillRandomTokens fill all the existing nodes with randomly chosen tokens, hands get count of them each.
     Token* dummyToken();
     Node*  randomNode();
     void fillNodesWithRandomTokens();
-    void fillHandsWithRandomTokens();
+    void fillHandsWithRandomTokens(int count = 5);
     void fillDecksWithRandomCards();
     void unusedCodeCemetery();
 
@@ -311,15 +430,13 @@ private:
     int  dropDie(int low, int high);
 
 public slots:
-    void autoMovement();
-    void autoMovementTogether();
-
     void viewMousePositionChanged(const QPoint& mousePosition);
     void onEditMode();
     void onSaveMap();
     void onLoadMap();
     void onDefaults();
     void onTurn();
+    void onSkipAnimation();
 };
 
 #endif // TABLE_H
@@ -0,0 +1,202 @@
+#include "animationclock.h"
+
+#include <QGuiApplication>
+#include <QScreen>
+#include <QtMath>
+
+AnimationClock::AnimationClock()
+{
+    m_timer.setTimerType(Qt::PreciseTimer);
+    connect(&m_timer, &QTimer::timeout, this, &AnimationClock::tick);
+
+    m_time.start();
+}
+
+AnimationClock &AnimationClock::instance()
+{
+    static AnimationClock clock;
+    return clock;
+}
+
+void AnimationClock::start(const void *owner, const Step &step)
+{
+    Animation animation;
+    animation.owner = owner;
+    animation.step = step;
+    animation.started = m_time.elapsed();
+
+    add(animation);
+}
+
+void AnimationClock::animate(const void *owner, int duration, const Update &update)
+{
+    Animation animation;
+    animation.owner = owner;
+    animation.update = update;
+    animation.started = m_time.elapsed();
+    animation.step = [update, duration](qint64 elapsed)
+    {
+        qreal progress = (duration > 0) ? qMin(qreal(1), qreal(elapsed) / duration) : qreal(1);
+        update(progress);
+        return progress >= 1;
+    };
+
+    add(animation);
+}
+
+void AnimationClock::finish(const void *owner)
+{
+    Update update;
+
+    int index = indexOf(owner);
+    if (index >= 0)
+        update = m_animations.at(index).update;
+
+    for (const Animation& animation : qAsConst(m_pending))
+        if (animation.owner == owner)
+            update = animation.update;
+
+    // The animation is removed first, so the update may start the next one of the same owner.
+    stop(owner);
+
+    if (update)
+        update(1);
+}
+
+void AnimationClock::stop(const void *owner)
+{
+    for (int i = 0; i < m_pending.count(); ++i)
+        if (m_pending.at(i).owner == owner)
+            m_pending.remove(i--);
+
+    int index = indexOf(owner);
+    if (index < 0)
+        return;
+
+    // Tick walks the list, so it is only marked there and compacted after the tick.
+    m_animations[index].owner = nullptr;
+    if (!m_ticking)
+        compact();
+}
+
+bool AnimationClock::isRunning(const void *owner) const
+{
+    if (indexOf(owner) >= 0)
+        return true;
+
+    for (const Animation& animation : m_pending)
+        if (animation.owner == owner)
+            return true;
+
+    return false;
+}
+
+int AnimationClock::count() const
+{
+    int count = m_pending.count();
+    for (const Animation& animation : m_animations)
+        if (animation.owner)
+            ++count;
+
+    return count;
+}
+
+int AnimationClock::interval() const
+{
+    QScreen* screen = QGuiApplication::primaryScreen();
+    qreal rate = (screen && screen->refreshRate() > 0) ? screen->refreshRate() : DEFAULT_REFRESH_RATE;
+
+    return qMax(1, qRound(1000 / rate));
+}
+
+// ************************************************** SLOTS
+
+void AnimationClock::tick()
+{
+    m_ticking = true;
+
+    QElapsedTimer frame;
+    frame.start();
+
+    qint64 now = m_time.elapsed();
+    int total = m_animations.count();
+    int done = 0;
+
+    // The walk starts where the previous tick has stopped, so each animation gets its turn, even if the budget is always exceeded.
+    while (done < total)
+    {
+        Animation& animation = m_animations[(m_cursor + done) % total];
+        ++done;
+
+        if (animation.owner && animation.step(now - animation.started))
+            animation.owner = nullptr;
+
+        if (frame.elapsed() >= FRAME_BUDGET)
+            break;
+    }
+
+    if (total > 0)
+        m_cursor = (m_cursor + done) % total;
+
+    m_ticking = false;
+    compact();
+}
+
+// ************************************************** PRIVATE
+
+int AnimationClock::indexOf(const void *owner) const
+{
+    for (int i = 0; i < m_animations.count(); ++i)
+        if (m_animations.at(i).owner == owner)
+            return i;
+
+    return -1;
+}
+
+void AnimationClock::add(const Animation &animation)
+{
+    if (m_ticking)
+    {
+        stop(animation.owner);
+        m_pending.append(animation);
+        return;
+    }
+
+    int index = indexOf(animation.owner);
+    if (index >= 0)
+        m_animations[index] = animation;
+    else
+        m_animations.append(animation);
+
+    if (!m_timer.isActive())
+        m_timer.start(interval());
+}
+
+void AnimationClock::compact()
+{
+    // Stopped and finished animations are dropped, the cursor keeps pointing to the same next one.
+    int kept = 0;
+    int cursor = 0;
+    for (int i = 0; i < m_animations.count(); ++i)
+    {
+        if (!m_animations.at(i).owner)
+            continue;
+
+        if (i < m_cursor)
+            ++cursor;
+
+        if (kept != i)
+            m_animations[kept] = m_animations.at(i);
+        ++kept;
+    }
+    m_animations.resize(kept);
+    m_cursor = (kept > 0) ? cursor % kept : 0;
+
+    m_animations.append(m_pending);
+    m_pending.clear();
+
+    if (m_animations.isEmpty())
+        m_timer.stop();
+    else if (!m_timer.isActive())
+        m_timer.start(interval());
+}
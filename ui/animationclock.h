@@ -0,0 +1,77 @@
+#ifndef ANIMATIONCLOCK_H
+#define ANIMATIONCLOCK_H
+
+#include <QObject>
+#include <QTimer>
+#include <QElapsedTimer>
+#include <QVector>
+
+#include <functional>
+
+// AnimationClock is the single frame timer of everything, that moves on the screen: gliding units, rolling die and so on.
+// Each animation used to own its timer, so the count of wakeups grew with the count of moving things.
+// Now they are registered on the clock and all of them are advanced by the same tick, once per frame of the display.
+// - the clock ticks at the refresh rate of the primary screen (DEFAULT_REFRESH_RATE, if it is unknown)
+//   and only while there are some animations, idle clock doesn't wake the application at all;
+// - animation is keyed by its owner, one owner has one animation, starting another one replaces the previous;
+// - step animations get the time passed since their start and return true, when they are finished;
+//   progress animations get the part of duration passed (from 0 to 1), they are finished after the call with 1;
+// - animations are time-based, so the tick, that took longer than FRAME_BUDGET ms, leaves the rest of them to the next frame,
+//   they are not slowed down, they just jump further, when their turn comes;
+// - finish jumps to the end of progress animation at once, stop drops the animation without finishing it,
+//   owners should stop their animations before they are deleted.
+// The clock is used from the GUI thread only.
+
+class AnimationClock : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int DEFAULT_REFRESH_RATE = 60;
+    static constexpr int FRAME_BUDGET = 8;
+
+    using Step   = std::function<bool(qint64 elapsed)>;
+    using Update = std::function<void(qreal progress)>;
+
+    static AnimationClock& instance();
+
+    // * start registers step animation of the owner;
+    // * animate registers progress animation of the owner, that lasts duration ms;
+    // * finish and stop end the animation of the owner, isRunning returns true, if the owner has one;
+    // * count returns count of running animations, interval returns the length of one frame in ms.
+    void start   (const void* owner, const Step& step);
+    void animate (const void* owner, int duration, const Update& update);
+    void finish  (const void* owner);
+    void stop    (const void* owner);
+    bool isRunning (const void* owner) const;
+    int  count    () const;
+    int  interval () const;
+
+private slots:
+    void tick ();
+
+private:
+    AnimationClock();
+    Q_DISABLE_COPY(AnimationClock)
+
+    struct Animation
+    {
+        const void* owner = nullptr; // null, if the animation has been stopped during the tick
+        Step        step;
+        Update      update;          // set for progress animations only, finish calls it with 1
+        qint64      started = 0;
+    };
+
+    int  indexOf (const void* owner) const;
+    void add     (const Animation& animation);
+    void compact ();
+
+    QTimer        m_timer;
+    QElapsedTimer m_time;
+    QVector<Animation> m_animations;
+    QVector<Animation> m_pending; // animations started during the tick, they are added after it
+    int  m_cursor = 0;            // the first animation of the next tick, when the previous one ran out of budget
+    bool m_ticking = false;
+};
+
+#endif // ANIMATIONCLOCK_H
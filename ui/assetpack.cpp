@@ -0,0 +1,275 @@
+#include "assetpack.h"
+
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QMap>
+#include <QSaveFile>
+#include <QSysInfo>
+#include <QtEndian>
+#include <QDebug>
+
+AssetPack::AssetPack()
+{
+}
+
+AssetPack &AssetPack::instance()
+{
+    static AssetPack pack;
+    return pack;
+}
+
+bool AssetPack::open(const QString &path)
+{
+    if (isOpen())
+    {
+        qDebug() << "AssetPack:: the pack is already open, images of it may be in use.";
+        return false;
+    }
+
+    m_directory = QFileInfo(path).absolutePath();
+
+    if (map(path))
+        return true;
+
+    // Broken pack is dropped as a whole, images come from loose files as if there were no pack at all.
+    m_index.clear();
+    m_data = nullptr;
+    m_file.close();
+    return false;
+}
+
+bool AssetPack::map(const QString &path)
+{
+    m_file.setFileName(path);
+    if (!m_file.open(QIODevice::ReadOnly))
+    {
+        qDebug() << "AssetPack:: there is no pack " << path << ", images are read from files of " << m_directory;
+        return false;
+    }
+
+    // 1. The whole file is mapped once, pages are read by the system, when images are drawn for the first time.
+    quint64 size = quint64(m_file.size());
+    if (size < quint64(HEADER_SIZE) || (m_data = m_file.map(0, m_file.size())) == nullptr)
+    {
+        qDebug() << "AssetPack:: could not map the pack " << path;
+        return false;
+    }
+
+    // 2. Header: the pack should be of this format and its pixels should have the byte order of this machine.
+    quint32 magic     = qFromLittleEndian<quint32>(m_data);
+    quint16 version   = qFromLittleEndian<quint16>(m_data + 4);
+    quint8  byteOrder = m_data[6];
+    quint32 count     = qFromLittleEndian<quint32>(m_data + 8);
+
+    quint64 namesOffset = HEADER_SIZE + quint64(count) * ENTRY_SIZE;
+    if (magic != MAGIC || version != FORMAT_VERSION || byteOrder != quint8(QSysInfo::ByteOrder) || namesOffset > size)
+    {
+        qDebug() << "AssetPack:: the pack " << path << " is of another format, rebuild it with monopoly-pack.";
+        return false;
+    }
+
+    // 3. Index: each entry should refer to its name and data inside the file.
+    m_index.reserve(int(count));
+    for (quint32 i = 0; i < count; ++i)
+    {
+        const uchar* record = m_data + HEADER_SIZE + quint64(i) * ENTRY_SIZE;
+        quint32 nameOffset = qFromLittleEndian<quint32>(record);
+        quint32 nameSize   = qFromLittleEndian<quint32>(record + 4);
+
+        Entry entry;
+        entry.offset       = qFromLittleEndian<quint64>(record + 8);
+        entry.size         = qFromLittleEndian<quint64>(record + 16);
+        entry.width        = int(qFromLittleEndian<quint32>(record + 24));
+        entry.height       = int(qFromLittleEndian<quint32>(record + 28));
+        entry.bytesPerLine = int(qFromLittleEndian<quint32>(record + 32));
+        entry.format       = int(qFromLittleEndian<quint32>(record + 36));
+
+        bool fits = namesOffset + nameOffset + nameSize <= size
+                 && entry.offset <= size && entry.size <= size - entry.offset
+                 && (entry.format == QImage::Format_Invalid || quint64(entry.bytesPerLine) * quint64(entry.height) <= entry.size);
+        if (!fits)
+        {
+            qDebug() << "AssetPack:: entry " << i << " of the pack " << path << " is out of the file.";
+            return false;
+        }
+
+        QString id = QString::fromUtf8(reinterpret_cast<const char*>(m_data + namesOffset + nameOffset), int(nameSize));
+        m_index.insert(id, entry);
+    }
+
+    qDebug() << "AssetPack:: mapped " << m_index.count() << " assets of " << path;
+    return true;
+}
+
+bool AssetPack::isOpen() const
+{
+    return m_data != nullptr;
+}
+
+int AssetPack::count() const
+{
+    return m_index.count();
+}
+
+bool AssetPack::contains(const QString &id) const
+{
+    return m_index.contains(id);
+}
+
+QImage AssetPack::image(const QString &id, bool *mapped) const
+{
+    if (mapped)
+        *mapped = false;
+
+    auto it = m_index.constFind(id);
+    if (it == m_index.constEnd())
+        return QImage(fileFor(id));
+
+    const Entry& entry = it.value();
+    const uchar* bytes = m_data + entry.offset;
+
+    if (entry.format == QImage::Format_Invalid)
+        return QImage::fromData(bytes, int(entry.size));
+
+    // Image is read-only view of mapped pixels, it is copied only if somebody paints on it.
+    if (mapped)
+        *mapped = true;
+
+    return QImage(bytes, entry.width, entry.height, entry.bytesPerLine, QImage::Format(entry.format));
+}
+
+QString AssetPack::fileFor(const QString &id) const
+{
+    int separator = id.indexOf('/');
+    if (separator <= 0 || m_directory.isEmpty() || QDir::isAbsolutePath(id))
+        return id;
+
+    QStringRef folder = id.leftRef(separator);
+    QString    name   = id.mid(separator + 1);
+    for (const Folder& f : FOLDERS)
+    {
+        if (folder != QLatin1String(f.id))
+            continue;
+
+        QString file = m_directory + '/' + QString::fromLatin1(f.directory) + '/' + name;
+        if (QFileInfo::exists(file))
+            return file;
+    }
+
+    return id;
+}
+
+bool AssetPack::build(const QString &directory, const QString &path, bool encoded)
+{
+    // Item is the asset to be written, data is either pixels or the bytes of file.
+    struct Item
+    {
+        Entry entry;
+        QByteArray data;
+    };
+
+    // 1. Assets of all folders, the first file with the same ID wins. Map keeps them sorted, so the pack is the same for the same files.
+    QMap<QString, Item> items;
+    for (const Folder& f : FOLDERS)
+    {
+        QDir dir (directory + '/' + QString::fromLatin1(f.directory));
+        const QStringList files = dir.entryList({"*.png", "*.jpg"}, QDir::Files, QDir::Name);
+        for (const QString& file : files)
+        {
+            QString id = QString::fromLatin1(f.id) + '/' + file;
+            if (items.contains(id))
+            {
+                qDebug() << "AssetPack:: " << dir.filePath(file) << " is skipped, there is another asset " << id;
+                continue;
+            }
+
+            QImage image (dir.filePath(file));
+            if (image.isNull())
+            {
+                qDebug() << "AssetPack:: can't read image " << dir.filePath(file);
+                continue;
+            }
+
+            Item item;
+            item.entry.width  = image.width();
+            item.entry.height = image.height();
+
+            if (encoded)
+            {
+                QFile source (dir.filePath(file));
+                if (!source.open(QIODevice::ReadOnly))
+                    continue;
+
+                item.data = source.readAll();
+            }
+            else
+            {
+                image = image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+                item.entry.bytesPerLine = image.bytesPerLine();
+                item.entry.format = image.format();
+                item.data = QByteArray(reinterpret_cast<const char*>(image.constBits()), int(image.sizeInBytes()));
+            }
+
+            item.entry.size = quint64(item.data.size());
+            items.insert(id, item);
+        }
+    }
+
+    // 2. Layout: names follow the index, data of each image starts at the aligned offset.
+    QByteArray names;
+    QVector<quint32> nameOffsets;
+    for (auto it = items.cbegin(); it != items.cend(); ++it)
+    {
+        nameOffsets.append(quint32(names.size()));
+        names.append(it.key().toUtf8());
+    }
+
+    auto aligned = [](quint64 offset) { return (offset + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT; };
+
+    quint64 offset = aligned(HEADER_SIZE + quint64(items.count()) * ENTRY_SIZE + quint64(names.size()));
+    for (Item& item : items)
+    {
+        item.entry.offset = offset;
+        offset = aligned(offset + item.entry.size);
+    }
+
+    // 3. Header, index, names and data are written into the temporary file, that replaces the old one only when it is complete.
+    QSaveFile file (path);
+    if (!file.open(QIODevice::WriteOnly))
+    {
+        qDebug() << "AssetPack:: could not write the pack " << path;
+        return false;
+    }
+
+    QDataStream stream (&file);
+    stream.setByteOrder(QDataStream::LittleEndian);
+
+    stream << MAGIC << FORMAT_VERSION << quint8(QSysInfo::ByteOrder) << quint8(0) << quint32(items.count()) << quint32(0);
+
+    int i = 0;
+    for (auto it = items.cbegin(); it != items.cend(); ++it, ++i)
+    {
+        const Entry& entry = it.value().entry;
+        stream << nameOffsets.at(i) << quint32(it.key().toUtf8().size()) << entry.offset << entry.size
+               << quint32(entry.width) << quint32(entry.height) << quint32(entry.bytesPerLine) << quint32(entry.format);
+    }
+
+    stream.writeRawData(names.constData(), names.size());
+
+    for (const Item& item : items)
+    {
+        QByteArray padding (int(item.entry.offset - quint64(file.pos())), '\0');
+        stream.writeRawData(padding.constData(), padding.size());
+        stream.writeRawData(item.data.constData(), item.data.size());
+    }
+
+    if (stream.status() != QDataStream::Ok || !file.commit())
+    {
+        qDebug() << "AssetPack:: could not write the pack " << path;
+        return false;
+    }
+
+    qDebug() << "AssetPack:: packed " << items.count() << " assets of " << directory << " into " << path << " (" << offset / 1024 << " KB)";
+    return true;
+}
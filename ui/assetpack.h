@@ -0,0 +1,96 @@
+#ifndef ASSETPACK_H
+#define ASSETPACK_H
+
+#include <QFile>
+#include <QHash>
+#include <QImage>
+#include <QString>
+
+// AssetPack is the single file with the artwork of tokens, cards and die, that is mapped into memory at startup.
+// Images used to be read from separate files (hundreds of opens on the start of the game), now they are resolved
+// by logical asset ID in the index of the pack, so starting the game opens and maps one file.
+// - asset ID is "<folder>/<filename>": "at/at_jail.png", "ot/fm.png", "cards/pb.png", "die/spritelist.png", "ui/icon.png",
+//   FOLDERS tell, which directories of data/ give the files of each folder (cards are split into positive and negative);
+// - the pack is the header (MAGIC, FORMAT_VERSION, byte order of pixels, count), the index of entries, sorted by ID,
+//   their names and the data of images, each of them is aligned to ALIGNMENT bytes;
+// - images are stored pre-decoded (ARGB32 premultiplied pixels), so they are drawn right from mapped memory without copying,
+//   or encoded (the bytes of original file), then the pack is small, but images are decoded on request;
+// - ID, that is not in the pack (or the pack couldn't be opened), is read from the loose file of data directory,
+//   any other path (chosen in node editor, stored in the old maps) is read as it is;
+// - catalogs and maps are not packed, but they are named by IDs too ("at/at.xml", "maps/not_round.tm"), fileFor finds them;
+// - the pack is not checked against data directory, it is rebuilt by monopoly-pack tool after artwork has been changed.
+// Images of the pack refer to mapped memory, which stays valid until the process ends.
+
+class AssetPack
+{
+public:
+    static constexpr quint32 MAGIC = 0x4d50414b; // "MPAK"
+    static constexpr quint16 FORMAT_VERSION = 1;
+    static constexpr int     ALIGNMENT = 16;
+    static constexpr const char* DEFAULT_PATH = "data/assets.pack";
+
+    // Folder of asset IDs and the directory relative to data directory, which files it has.
+    struct Folder
+    {
+        const char* id;
+        const char* directory;
+    };
+
+    static constexpr Folder FOLDERS[] = {
+        {"at",    "tokens/at"},
+        {"ot",    "tokens/ot"},
+        {"cards", "cards"},
+        {"cards", "cards/positive"},
+        {"cards", "cards/negative"},
+        {"die",   "die"},
+        {"ui",    "ui"},
+        {"maps",  "maps"}
+    };
+
+    static AssetPack& instance();
+
+    // * open maps the pack at path, loose files are looked for in the directory of the pack,
+    //   returns false, if the pack is absent or broken (then all images come from loose files), it is called once at startup;
+    // * isOpen returns true, if the pack has been mapped, count returns the count of its assets;
+    // * contains returns true, if the pack has the asset with the id;
+    // * image returns the image of asset id or of the file at path, mapped is set to true, if the image refers to the pack memory;
+    // * fileFor returns the loose file for asset id in data directory, or id itself, if there is no such file.
+    bool open (const QString& path);
+    bool isOpen () const;
+    int  count () const;
+    bool contains (const QString& id) const;
+
+    QImage  image   (const QString& id, bool* mapped = nullptr) const;
+    QString fileFor (const QString& id) const;
+
+    // * build packs the images of FOLDERS from data directory into the file at path,
+    //   encoded keeps the bytes of original files instead of decoded pixels, returns false, if the pack could not be written.
+    static bool build (const QString& directory, const QString& path, bool encoded);
+
+private:
+    AssetPack();
+    Q_DISABLE_COPY(AssetPack)
+
+    static constexpr int HEADER_SIZE = 16;
+    static constexpr int ENTRY_SIZE  = 40;
+
+    // Entry is the record of index, format is QImage::Format of pixels or Format_Invalid for encoded file.
+    struct Entry
+    {
+        quint64 offset = 0;
+        quint64 size = 0;
+        int width = 0;
+        int height = 0;
+        int bytesPerLine = 0;
+        int format = QImage::Format_Invalid;
+    };
+
+    bool map (const QString& path);
+
+    QFile   m_file;
+    QString m_directory;
+    const uchar* m_data = nullptr;
+    QHash<QString, Entry> m_index;
+};
+
+#endif // ASSETPACK_H
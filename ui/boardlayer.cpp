@@ -0,0 +1,172 @@
+#include "boardlayer.h"
+
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QtMath>
+
+#include "ui/imagecache.h"
+#include "ui/paintresources.h"
+
+BoardLayer::BoardLayer(const QSize &nodeSize, int columns, int rows)
+    : QGraphicsItem()
+    , m_nodeSize (nodeSize)
+    , m_columns (columns)
+    , m_rows (rows)
+{
+    setZValue(Z_VALUE);
+
+    // Exposed rect lets the layer copy only the part of the cache, that was uncovered by the moving item.
+    setFlag(QGraphicsItem::ItemUsesExtendedStyleOption);
+}
+
+void BoardLayer::setNodes(const QList<Node*> *nodes, const GridIndex<Node*>* grid)
+{
+    m_nodes = nodes;
+    m_grid = grid;
+    invalidate();
+}
+
+void BoardLayer::invalidate()
+{
+    // Custom maps may grow the grid beyond the default board, so the bounds may change too.
+    prepareGeometryChange();
+    m_dirty = true;
+    update();
+}
+
+QRect BoardLayer::cells() const
+{
+    QRect board (0, 0, m_columns, m_rows);
+    return (m_grid && !m_grid->bounds().isEmpty()) ? board.united(m_grid->bounds()) : board;
+}
+
+QRectF BoardLayer::boundingRect() const
+{
+    // Border lines are 2px wide, so the half of them lies outside of the board.
+    QRect range = cells();
+    QRectF board (range.x() * m_nodeSize.width(), range.y() * m_nodeSize.height(),
+                  range.width() * m_nodeSize.width(), range.height() * m_nodeSize.height());
+
+    return board.adjusted(-1, -1, 1, 1);
+}
+
+QPainterPath BoardLayer::shape() const
+{
+    return QPainterPath();
+}
+
+void BoardLayer::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+    Q_UNUSED(widget);
+
+    QRectF bounds  = boundingRect();
+    QRectF exposed = option ? option->exposedRect.intersected(bounds) : bounds;
+    if (exposed.isEmpty())
+        return;
+
+    qreal lod = option ? option->levelOfDetailFromTransform(painter->worldTransform()) : 1.0;
+    Node::Detail detail = Node::detailFor(lod);
+
+    // Scale includes the zoom of the view, so the cache is drawn 1:1 and zoomed out board gives the small cache.
+    qreal scale = ImageCache::ratioFor(painter);
+    if (qMax(bounds.width(), bounds.height()) * scale > MAX_CACHE_SIDE)
+    {
+        paintDirect(painter, exposed, detail);
+        return;
+    }
+
+    bool themeChanged = (m_revision != PaintResources::instance().revision());
+    if (m_dirty || themeChanged || detail != m_detail || m_cache.isNull() || !qFuzzyCompare(m_cache.devicePixelRatioF(), scale))
+        render(scale, detail);
+
+    // Source rect is in device pixels of the cache, that starts at the top left corner of bounds.
+    QRectF source = exposed.translated(-bounds.topLeft());
+    painter->drawPixmap(exposed, m_cache, QRectF(source.topLeft() * scale, source.size() * scale));
+}
+
+void BoardLayer::render(qreal scale, Node::Detail detail)
+{
+    QRectF bounds = boundingRect();
+
+    m_cache = QPixmap((bounds.size() * scale).toSize());
+    m_cache.setDevicePixelRatio(scale);
+    m_cache.fill(Qt::transparent);
+
+    QPainter painter (&m_cache);
+    painter.translate(-bounds.topLeft());
+
+    drawGrid(&painter, cells());
+
+    if (m_nodes)
+    {
+        for (Node* node : *m_nodes)
+        {
+            painter.save();
+            node->draw(&painter, detail);
+            painter.restore();
+        }
+    }
+
+    m_detail = detail;
+    m_dirty = false;
+    m_revision = PaintResources::instance().revision();
+}
+
+void BoardLayer::paintDirect(QPainter *painter, const QRectF &exposed, Node::Detail detail)
+{
+    // Cells, that intersect the exposed rect, are the only ones to paint.
+    QRect range = cells();
+    int left   = qMax(range.left(),   int(qFloor(exposed.left()   / m_nodeSize.width())));
+    int right  = qMin(range.right(),  int(qFloor(exposed.right()  / m_nodeSize.width())));
+    int top    = qMax(range.top(),    int(qFloor(exposed.top()    / m_nodeSize.height())));
+    int bottom = qMin(range.bottom(), int(qFloor(exposed.bottom() / m_nodeSize.height())));
+    if (left > right || top > bottom)
+        return;
+
+    painter->save();
+    painter->setClipRect(exposed);
+    drawGrid(painter, QRect(QPoint(left, top), QPoint(right, bottom)));
+    painter->restore();
+
+    if (!m_grid)
+        return;
+
+    for (int y = top; y <= bottom; ++y)
+    {
+        for (int x = left; x <= right; ++x)
+        {
+            Node* node = m_grid->at(QPoint(x, y));
+            if (!node)
+                continue;
+
+            painter->save();
+            node->draw(painter, detail);
+            painter->restore();
+        }
+    }
+}
+
+void BoardLayer::drawGrid(QPainter *painter, const QRect &range)
+{
+    // Outer lines of the whole board use the border pen, the rest are dashed.
+    QRect board = cells();
+    int width  = m_nodeSize.width();
+    int height = m_nodeSize.height();
+
+    const QPen& pen_inner  = PaintResources::instance().pen(PaintResources::Pen::GRID_INNER);
+    const QPen& pen_border = PaintResources::instance().pen(PaintResources::Pen::GRID_BORDER);
+
+    // Vertical lines
+    for (int x = range.left(); x <= range.right() + 1; ++x)
+    {
+        painter->setPen((x == board.left() || x == board.right() + 1) ? pen_border : pen_inner);
+        painter->drawLine(QLineF(x * width, range.top() * height, x * width, (range.bottom() + 1) * height));
+    }
+
+    // Horizontal lines
+    for (int y = range.top(); y <= range.bottom() + 1; ++y)
+    {
+        painter->setPen((y == board.top() || y == board.bottom() + 1) ? pen_border : pen_inner);
+        painter->drawLine(QLineF(range.left() * width, y * height, (range.right() + 1) * width, y * height));
+    }
+}
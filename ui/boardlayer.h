@@ -0,0 +1,62 @@
+#ifndef BOARDLAYER_H
+#define BOARDLAYER_H
+
+#include <QGraphicsItem>
+#include <QPainterPath>
+#include <QPixmap>
+#include <QList>
+#include <QSize>
+#include <QRect>
+
+#include "core/gridindex.h"
+#include "nodes/node.h"
+
+// BoardLayer is the static layer of the table: grid lines, nodes and their tokens.
+// They change only when the map is edited or the token is placed, so they are rendered once into the cached pixmap.
+// Dynamic items (units, hands, decks, details and menu) lie above it and repaint on their own;
+// when one of them moves, only the exposed part of the cached pixmap is drawn again.
+// - nodes are not the items of the scene anymore, the layer paints them using their own draw method;
+// - the cache is rendered at the scale of the view and with the level of detail of nodes, that suits this scale,
+//   so zoomed out board is made of flat cells and is cheap to render, however many nodes it has;
+// - if the cache would be larger than MAX_CACHE_SIDE px (large board seen close), nodes in the exposed rect are painted directly,
+//   they are found in the grid index, so the cost depends on the visible part only;
+// - invalidate drops the cache, it is rendered again on the next paint (also when scale, level of detail or theme changes);
+// - shape is empty, so the layer is never found by itemAt and nodes should be looked for in the grid index;
+// - Z_VALUE places the layer below everything else.
+
+class BoardLayer : public QGraphicsItem
+{
+public:
+    static constexpr qreal Z_VALUE = -1.0;
+    static constexpr int   MAX_CACHE_SIDE = 4096;
+
+    BoardLayer(const QSize& nodeSize, int columns, int rows);
+
+    // * setNodes sets the list of nodes to render and their index by grid positions, both are owned by the table;
+    // * invalidate drops the cached pixmap and schedules the repaint of the layer.
+    void setNodes (const QList<Node*>* nodes, const GridIndex<Node*>* grid);
+    void invalidate ();
+
+    QRectF boundingRect() const override;
+    QPainterPath shape() const override;
+    void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget = Q_NULLPTR) override;
+
+private:
+    QRect cells () const;
+    void  render      (qreal scale, Node::Detail detail);
+    void  paintDirect (QPainter* painter, const QRectF& exposed, Node::Detail detail);
+    void  drawGrid    (QPainter* painter, const QRect& range);
+
+    QSize m_nodeSize;
+    int   m_columns;
+    int   m_rows;
+    const QList<Node*>*     m_nodes = nullptr;
+    const GridIndex<Node*>* m_grid = nullptr;
+
+    QPixmap      m_cache;
+    Node::Detail m_detail = Node::Detail::FULL;
+    bool         m_dirty = true;
+    int          m_revision = 0; // revision of paint resources used for the cache
+};
+
+#endif // BOARDLAYER_H
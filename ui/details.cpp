@@ -6,6 +6,9 @@
 
 #include "player/player.h"
 #include "ui/uielementfactory.h"
+#include "ui/imagecache.h"
+#include "ui/paintresources.h"
+#include "ui/textcache.h"
 
 Details::Details()
 {
@@ -194,13 +197,12 @@ void Details::showButtons()
 
 void Details::drawBackground(QPainter *painter)
 {
-    QPen borderPen = QPen(QBrush(Qt::darkGray), 3.0f);
-    QColor backgroundColor = QColor("#333"); backgroundColor.setAlpha(200);
+    const PaintResources& resources = PaintResources::instance();
 
     painter->setRenderHint(QPainter::Antialiasing);
-    painter->setPen(borderPen);
+    painter->setPen(resources.pen(PaintResources::Pen::DETAILS_BORDER));
     painter->drawRect(rect());
-    painter->fillRect(rect(), backgroundColor);
+    painter->fillRect(rect(), resources.brush(PaintResources::Brush::DETAILS_BACKGROUND));
 
     if (m_closeButton)
         m_closeButton->paint(painter, nullptr, nullptr);
@@ -209,15 +211,16 @@ void Details::drawBackground(QPainter *painter)
 void Details::drawAT(QPainter* painter)
 {
     // 1. Prepare drawing instruments    
-    QPen textPen = QPen(Qt::white);
+    const PaintResources& resources = PaintResources::instance();
+    TextCache& texts = TextCache::instance();
 
     // 2. Draw action token details
-    painter->setPen(textPen);
-    painter->setFont(QFont("Comic Sans", 7));
-    painter->drawImage(QRectF(rect().x(),       rect().y(),      300, 300), m_actionToken->image());
-    painter->drawText(QRectF (rect().x() + 310, rect().y(),      190,  20), m_actionToken->name(), QTextOption(Qt::AlignCenter));
+    painter->setPen(resources.pen(PaintResources::Pen::TEXT));
+    painter->setFont(resources.font(PaintResources::Font::SMALL));
+    ImageCache::instance().draw(painter, QRectF(rect().x(), rect().y(), 300, 300), m_actionToken->imagePath());
+    texts.draw(painter, QRectF (rect().x() + 310, rect().y(),      190,  20), m_actionToken->name(), resources.text(PaintResources::Text::CENTER));
     painter->drawLine(rect().x() + 330, rect().y() + 20, rect().x() + 480, rect().y() + 20);
-    painter->drawText(QRectF (rect().x() + 310, rect().y() + 30, 190, 290), m_actionToken->description(), QTextOption(Qt::AlignCenter | Qt::AlignTop));
+    texts.draw(painter, QRectF (rect().x() + 310, rect().y() + 30, 190, 290), m_actionToken->description(), resources.text(PaintResources::Text::CENTER_TOP));
 }
 
 void Details::drawOT(QPainter* painter)
@@ -234,34 +237,36 @@ void Details::drawOT(QPainter* painter)
     QString overviewUpgradeIncome = QString("%1, %2, %3.").arg(income.at(0)).arg(income.at(1)).arg(income.at(2));
     QString overviewUpgradeCost   = QString("%1, %2, %3.").arg(cost.at(0)).arg(cost.at(1)).arg(cost.at(2));
 
-    QImage upgradeImage = QImage(QString("D:/monopoly/at/stars_%1.png").arg(m_ownershipToken->upgradeLevel()));
+    QString upgradeImage = QString("at/stars_%1.png").arg(m_ownershipToken->upgradeLevel());
+    ImageCache& images = ImageCache::instance();
 
     // 2. Prepare drawing instruments
-    QPen borderPen = QPen(QBrush(Qt::darkGray), 5);
-    QPen basicTextPen = QPen(Qt::white);
-    QPen buyingTextPen = QPen(Qt::green);
-    QPen upgradeTextPen = QPen(Qt::lightGray);
+    const PaintResources& resources = PaintResources::instance();
+    TextCache& texts = TextCache::instance();
+    const QPen& basicTextPen   = resources.pen(PaintResources::Pen::TEXT);
+    const QPen& buyingTextPen  = resources.pen(PaintResources::Pen::TEXT_BUYING);
+    const QPen& upgradeTextPen = resources.pen(PaintResources::Pen::TEXT_UPGRADE);
 
     // 4. Draw ownership token details
     int margin = 5;
 
     painter->setPen(basicTextPen);
-    painter->setFont(QFont("Comic Sans", 7));
-        painter->drawImage(QRectF(rect().x(),                rect().y(),      300, 300), m_ownershipToken->image());
-        painter->drawImage(QRectF(rect().x(),                rect().y(),      300, 300), upgradeImage);
-        painter->drawText(QRectF (rect().x() + 300 + margin, rect().y(),      190,  20), m_ownershipToken->name(), QTextOption(Qt::AlignCenter));
+    painter->setFont(resources.font(PaintResources::Font::SMALL));
+        images.draw(painter, QRectF(rect().x(),              rect().y(),      300, 300), m_ownershipToken->imagePath());
+        images.draw(painter, QRectF(rect().x(),              rect().y(),      300, 300), upgradeImage);
+        texts.draw(painter, QRectF (rect().x() + 300 + margin, rect().y(),      190,  20), m_ownershipToken->name(), resources.text(PaintResources::Text::CENTER));
         painter->drawLine(QPointF(rect().x() + 330, rect().y() + 20), QPointF(rect().x() + 470, rect().y() + 20));
-        painter->drawText(QRectF (rect().x() + 300 + margin, rect().y() + 30, 190, 15), "Owner:" + owner, QTextOption(Qt::AlignCenter));
-        painter->drawText(QRectF (rect().x() + 300 + margin, rect().y() + 45, 190, 290), m_ownershipToken->description(), QTextOption(Qt::AlignCenter | Qt::AlignTop));
+        texts.draw(painter, QRectF (rect().x() + 300 + margin, rect().y() + 30, 190, 15), "Owner:" + owner, resources.text(PaintResources::Text::CENTER));
+        texts.draw(painter, QRectF (rect().x() + 300 + margin, rect().y() + 45, 190, 290), m_ownershipToken->description(), resources.text(PaintResources::Text::CENTER_TOP));
     painter->setPen(buyingTextPen);
-        painter->drawText(QPointF(rect().x() + margin,       rect().y() + 310), "Buying cost: " + buyingCost);
+        texts.draw(painter, QPointF(rect().x() + margin,       rect().y() + 310), "Buying cost: " + buyingCost);
     painter->setPen(basicTextPen);
-        painter->drawText(QPointF(rect().x() + margin,       rect().y() + 325), "Income: " + currentIncome);
-        painter->drawText(QPointF(rect().x() + margin,       rect().y() + 340), "Upgrade level: " + currentUpgradeLevel);
-        painter->drawText(QPointF(rect().x() + margin,       rect().y() + 355), "Upgrade cost: " + currentUpgradeCost);
+        texts.draw(painter, QPointF(rect().x() + margin,       rect().y() + 325), "Income: " + currentIncome);
+        texts.draw(painter, QPointF(rect().x() + margin,       rect().y() + 340), "Upgrade level: " + currentUpgradeLevel);
+        texts.draw(painter, QPointF(rect().x() + margin,       rect().y() + 355), "Upgrade cost: " + currentUpgradeCost);
     painter->setPen(upgradeTextPen);
-        painter->drawText(QPointF(rect().x() + margin,       rect().y() + 370), "(Overview) Upgrade income: " + overviewUpgradeIncome);
-        painter->drawText(QPointF(rect().x() + margin,       rect().y() + 385), "(Overview) Upgrade cost: " + overviewUpgradeCost);
+        texts.draw(painter, QPointF(rect().x() + margin,       rect().y() + 370), "(Overview) Upgrade income: " + overviewUpgradeIncome);
+        texts.draw(painter, QPointF(rect().x() + margin,       rect().y() + 385), "(Overview) Upgrade cost: " + overviewUpgradeCost);
 
     // 5. Draw buttons
         qDebug() << "Paint. BBR:  " << m_buyButton->boundingRect();
@@ -284,17 +289,18 @@ void Details::drawOT(QPainter* painter)
 void Details::drawCard(QPainter *painter)
 {
     // 1. Prepare drawing instruments
-    QPen textPen = QPen(Qt::white);
+    const PaintResources& resources = PaintResources::instance();
+    TextCache& texts = TextCache::instance();
 
     // qDebug() << m_card->imageFrontFG().width() << ":" << m_card->imageFrontFG().height();
 
     // 2. Draw action token details
-    painter->setPen(textPen);
-    painter->setFont(QFont("Comic Sans", 7));
-    painter->drawImage(QRectF(rect().x(),       rect().y(),      300, 300), m_card->imageFrontFG());
-    painter->drawText(QRectF (rect().x() + 310, rect().y(),      190,  20), m_card->name(), QTextOption(Qt::AlignCenter));
+    painter->setPen(resources.pen(PaintResources::Pen::TEXT));
+    painter->setFont(resources.font(PaintResources::Font::SMALL));
+    ImageCache::instance().draw(painter, QRectF(rect().x(), rect().y(), 300, 300), m_card->foregroundPath());
+    texts.draw(painter, QRectF (rect().x() + 310, rect().y(),      190,  20), m_card->name(), resources.text(PaintResources::Text::CENTER));
     painter->drawLine(rect().x() + 330, rect().y() + 20, rect().x() + 480, rect().y() + 20);
-    painter->drawText(QRectF (rect().x() + 310, rect().y() + 30, 190, 290), m_card->description(), QTextOption(Qt::AlignCenter | Qt::AlignTop));
+    texts.draw(painter, QRectF (rect().x() + 310, rect().y() + 30, 190, 290), m_card->description(), resources.text(PaintResources::Text::CENTER_TOP));
 
     // 3. Draw use button
     if (m_useButton && !m_useButton->isHidden())
@@ -330,7 +336,7 @@ UIElement* Details::createButton(const QString &text, const QSize &size, const Q
     button->setShape(UIElement::Shape::RECTANGLE);
     button->setBorderWidth(2);
     button->setPen(QPen(Qt::white));
-    button->setFont(QFont("Comic Sans", 10));
+    button->setFont(PaintResources::Font::BASIC);
 
     return button;
 }
@@ -1,15 +1,17 @@
 #include "die.h"
 
-#include <QFileInfo>
+#include "ui/animationclock.h"
+#include "ui/assetpack.h"
 #include <QDebug>
 
 Die::Die()
 {
-    loadSpritelist(6, QSize(100, 100), "D:/monopoly/die/spritelist.png");
+    loadSpritelist(6, QSize(100, 100), "die/spritelist.png");
 }
 
 Die::~Die()
 {
+    AnimationClock::instance().stop(this);
     clear();
 }
 
@@ -18,9 +20,19 @@ void Die::drop()
     m_stopped = false;
     m_stopping = false;
     m_interval = 55;
+    m_nextFrame = 0;
 
-    connect(&m_dropTimer, SIGNAL(timeout()), this, SLOT(onDieDropped()));
-    m_dropTimer.start(m_interval);
+    // Frames are changed by the shared animation clock, the die only decides, if the next one is due.
+    AnimationClock::instance().start(this, [this](qint64 elapsed)
+    {
+        if (elapsed >= m_nextFrame)
+        {
+            onDieDropped();
+            m_nextFrame = elapsed + m_interval;
+        }
+
+        return m_stopped;
+    });
 }
 
 void Die::stop()
@@ -53,17 +65,17 @@ void Die::clear()
     m_spritelist = nullptr;
 }
 
-void Die::loadSpritelist(int frames, const QSize& framesize, const QString &filename)
+void Die::loadSpritelist(int frames, const QSize& framesize, const QString &asset)
 {
-    QFileInfo fi (filename);
-    if (fi.exists() && fi.suffix() == "png")
+    // Frames are copied out of the spritelist, so it is taken from the pack directly, without keeping it in the image cache.
+    QImage spritelist = AssetPack::instance().image(asset);
+    if (!spritelist.isNull())
     {
-        QImage spritelist (filename);
         prepareSpritelist (frames, framesize, spritelist);
     }
     else
     {
-        qDebug() << QString("There is no image with the name %1.").arg(filename);
+        qDebug() << QString("There is no image with the name %1.").arg(asset);
     }
 }
 
@@ -89,6 +101,7 @@ void Die::onDieDropped()
     if (!m_spritelist || m_spritelist->isEmpty())
     {
         qDebug() << "There is no frames data.";
+        m_stopped = true;
         return;
     }
 
@@ -116,10 +129,8 @@ void Die::onDieDropped()
         if (m_interval > 1000)
         {
             // if interval gets to some value, find the value connected to image and set it as current value
+            // the clock drops the animation, when it sees the die stopped
             m_stopped = true;
-
-            m_dropTimer.stop();
-            disconnect(&m_dropTimer, SIGNAL(timeout()), this, SLOT(onDieDropped()));
         }
     }
 }
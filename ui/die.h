@@ -1,8 +1,6 @@
 #ifndef DIE_H
 #define DIE_H
 
-#include <QTimer>
-
 #include "uielement.h"
 
 class Die : public QObject
@@ -23,7 +21,7 @@ public:
 private:
     void clear();
 
-    void loadSpritelist    (int frames, const QSize& framesize, const QString& filename);
+    void loadSpritelist    (int frames, const QSize& framesize, const QString& asset);
     void prepareSpritelist (int frames, const QSize& framesize, const QImage&  spritelist);
 
     // use this class
@@ -39,12 +37,12 @@ private:
     // move view relative stuff to some other class
     // UIElement* m_dropDieButton;
 
-    // when user turns on some button: the timer starts and spritelist begins to change the images rapidly (var.1)
-    // when user turns of the button : the timer slows down () and eventually stops
+    // when user turns on some button: the die starts rolling on the animation clock and spritelist begins to change the images rapidly (var.1)
+    // when user turns of the button : the frames slow down () and eventually stop
     // the got image is compared then with the one in the list and corresponding integer value is returned and set as a current value
-    QTimer m_dropTimer;
     bool   m_stopping;
-    int    m_interval; // interval between timer ticks in milliseconds
+    int    m_interval;  // interval between frames in milliseconds
+    qint64 m_nextFrame; // time since the drop, when the next frame should be shown
 
 signals:
 
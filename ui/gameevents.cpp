@@ -0,0 +1,7 @@
+#include "gameevents.h"
+
+GameEvents::GameEvents(QObject *parent)
+    : QObject (parent)
+{
+
+}
@@ -0,0 +1,36 @@
+#ifndef GAMEEVENTS_H
+#define GAMEEVENTS_H
+
+#include <QObject>
+#include <QPoint>
+
+class Player;
+class Card;
+class OwnershipToken;
+
+// GameEvents is the bus of things, that happen to players during the game.
+// Rules only tell the bus, what has changed, and views, that show it, subscribe to relevant signals.
+// So there is no need to know at each point of the rules, which hands, nodes and labels should be repainted.
+// - goldChanged: the player received or paid some gold;
+// - companiesChanged: companies of the player were upgraded, or their income was doubled or stopped;
+// - ownershipChanged: the company passed from one player to another (previous is nullptr, when it was bought);
+// - unitMoved: the unit of the player moved from one grid position to another;
+// - cardTaken and cardUsed: the card was put into the hand of the player or activated from it.
+
+class GameEvents : public QObject
+{
+    Q_OBJECT
+
+public:
+    explicit GameEvents(QObject* parent = nullptr);
+
+signals:
+    void goldChanged      (Player* player);
+    void companiesChanged (Player* player);
+    void ownershipChanged (OwnershipToken* company, Player* previous, Player* owner);
+    void unitMoved        (Player* player, const QPoint& from, const QPoint& to);
+    void cardTaken        (Player* player, Card* card);
+    void cardUsed         (Player* player, Card* card);
+};
+
+#endif // GAMEEVENTS_H
@@ -66,6 +66,19 @@ void HistoryLabel::logToFile(const QString &filename)
     }
 }
 
+void HistoryLabel::suspend()
+{
+    ++m_suspended;
+}
+
+void HistoryLabel::resume()
+{
+    if (m_suspended == 0 || --m_suspended > 0)
+        return;
+
+    showMessage();
+}
+
 void HistoryLabel::makeConnections()
 {
     connect (this, SIGNAL(messageChanged(bool)), this, SLOT(onMessageChanged(bool)));
@@ -82,7 +95,8 @@ void HistoryLabel::addMessage(const QString &message)
     m_messages.append(message);
     m_currentMessageIndex = m_messages.count() - 1;
 
-    showMessage();
+    if (m_suspended == 0)
+        showMessage();
 }
 
 void HistoryLabel::onMessageChanged(bool toPrevious)
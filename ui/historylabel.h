@@ -17,6 +17,12 @@ public:
 
     void logToFile(const QString& filename);
 
+    // Batching:
+    // * suspend stops showing added messages, they are just stored in the list;
+    // * resume shows the last of them once. Calls may be nested, messages are shown after the outermost resume.
+    void suspend();
+    void resume();
+
 private:
     void makeConnections();
     void showMessage();
@@ -24,6 +30,7 @@ private:
     // List of messages and index of current message.
     int m_currentMessageIndex;
     QStringList m_messages;
+    int m_suspended = 0;
 
 signals:
     void messageChanged(bool toPrevious);
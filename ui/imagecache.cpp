@@ -0,0 +1,125 @@
+#include "imagecache.h"
+
+#include <QPainter>
+#include <QPaintDevice>
+#include <QtMath>
+#include <QDebug>
+
+#include "ui/assetpack.h"
+
+ImageCache::ImageCache()
+{
+    m_pixmaps.setMaxCost(PIXMAPS_BUDGET);
+    m_sources.setMaxCost(SOURCES_BUDGET);
+}
+
+ImageCache &ImageCache::instance()
+{
+    static ImageCache cache;
+    return cache;
+}
+
+QImage ImageCache::source(const QString &path)
+{
+    if (path.isEmpty())
+        return QImage();
+
+    QImage* cached = m_sources.object(path);
+    if (cached)
+        return *cached;
+
+    // Pre-decoded images of the pack refer to its mapped memory, they are not counted by the budget and not cached,
+    // because making them again costs only the lookup in the index.
+    bool mapped = false;
+    QImage image = AssetPack::instance().image(path, &mapped);
+    if (mapped)
+        return image;
+
+    if (image.isNull())
+        qDebug() << "ImageCache:: can't read image " << path;
+
+    // Copy is returned, because the cache deletes the object, that doesn't fit the budget, right on insertion.
+    m_sources.insert(path, new QImage(image), costOf(image));
+    return image;
+}
+
+QPixmap ImageCache::pixmap(const QString &path, const QSize &size, qreal devicePixelRatio)
+{
+    if (path.isEmpty() || size.isEmpty())
+        return QPixmap();
+
+    QString key = keyFor(path, size, devicePixelRatio);
+    QPixmap* cached = m_pixmaps.object(key);
+    if (cached)
+        return *cached;
+
+    QPixmap result;
+    QImage  image = source(path);
+    if (!image.isNull())
+    {
+        // Scaling is made once, so it can afford the smooth transformation.
+        QSize deviceSize = (QSizeF(size) * devicePixelRatio).toSize();
+        result = QPixmap::fromImage(image.scaled(deviceSize, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+        result.setDevicePixelRatio(devicePixelRatio);
+    }
+
+    m_pixmaps.insert(key, new QPixmap(result), costOf(result));
+    return result;
+}
+
+bool ImageCache::draw(QPainter *painter, const QRectF &target, const QString &path)
+{
+    QSize size = target.size().toSize();
+    QPixmap image = pixmap(path, size, ratioFor(painter));
+    if (image.isNull())
+        return false;
+
+    painter->drawPixmap(target, image, QRectF(QPointF(0, 0), QSizeF(image.size())));
+    return true;
+}
+
+void ImageCache::setBudget(int kilobytes)
+{
+    m_pixmaps.setMaxCost(kilobytes);
+}
+
+int ImageCache::budget() const
+{
+    return m_pixmaps.maxCost();
+}
+
+void ImageCache::clear()
+{
+    m_pixmaps.clear();
+    m_sources.clear();
+}
+
+qreal ImageCache::ratioFor(const QPainter *painter)
+{
+    qreal ratio = (painter && painter->device()) ? painter->device()->devicePixelRatioF() : 1.0;
+    if (!painter)
+        return ratio;
+
+    // Scale of the transform is the length of the mapped unit vector, it stays correct for rotated items (decks).
+    // It is rounded to 1/8, so the smooth zoom doesn't fill the cache with the pixmaps of almost the same size.
+    const QTransform& transform = painter->combinedTransform();
+    qreal scale = qSqrt(transform.m11() * transform.m11() + transform.m12() * transform.m12());
+    scale = qMax(qreal(0.125), qRound(scale * 8) / qreal(8));
+
+    return ratio * scale;
+}
+
+QString ImageCache::keyFor(const QString &path, const QSize &size, qreal devicePixelRatio)
+{
+    return QString("%1|%2x%3@%4").arg(path).arg(size.width()).arg(size.height()).arg(devicePixelRatio);
+}
+
+int ImageCache::costOf(const QImage &image)
+{
+    return qMax(1, int(image.sizeInBytes() / 1024));
+}
+
+int ImageCache::costOf(const QPixmap &pixmap)
+{
+    return qMax(1, int(qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8 / 1024));
+}
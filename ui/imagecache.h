@@ -0,0 +1,62 @@
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include <QCache>
+#include <QPixmap>
+#include <QImage>
+#include <QString>
+#include <QRectF>
+
+class QPainter;
+
+// ImageCache is the process-wide storage of the artwork of tokens and cards, prepared for drawing.
+// Paint methods used to decode files and scale images each time they were called, now they ask the cache
+// for the pixmap of specific size and get the one, that has been made on the first request.
+// - the pixmap is keyed by (path, target size, device pixel ratio) and has size * ratio device pixels,
+//   ratio includes the scale of the painter transform, so zoomed or rotated items are not rescaled on drawing too;
+// - decoded source images are kept separately, so each file is read from disk once for all of its sizes,
+//   tokens and cards take their images from there as well and share the same data;
+// - path is the asset ID of AssetPack (or the path of any other file), pre-decoded images of the pack are drawn
+//   right from its mapped memory, only the images, that had to be decoded, are kept in the storage of sources;
+// - both storages are LRU caches limited by memory budget in kilobytes, least recently used entries are dropped first;
+// - the path, that can't be read, gives the null image and it is remembered too, so the file is not read again.
+// The cache is used from the GUI thread only, as QPixmap requires.
+
+class ImageCache
+{
+public:
+    static constexpr int PIXMAPS_BUDGET = 64 * 1024;
+    static constexpr int SOURCES_BUDGET = 32 * 1024;
+
+    static ImageCache& instance();
+
+    // * source returns the decoded image of asset ID or file path at its original size;
+    // * pixmap returns the image from path scaled to size for specific device pixel ratio;
+    // * draw puts the pixmap of target size into target rect, the ratio is taken from the painter,
+    //   returns false, if there is nothing to draw;
+    // * setBudget changes the memory limit of pixmaps, clear drops everything (if artwork files have been changed).
+    QImage  source (const QString& path);
+    QPixmap pixmap (const QString& path, const QSize& size, qreal devicePixelRatio);
+    bool    draw   (QPainter* painter, const QRectF& target, const QString& path);
+
+    void setBudget (int kilobytes);
+    int  budget () const;
+    void clear ();
+
+    // * ratioFor returns device pixel ratio of the painter multiplied by the scale of its transform,
+    //   items, that cache their own composites, use it to render them at the resolution of the screen.
+    static qreal ratioFor (const QPainter* painter);
+
+private:
+    ImageCache();
+    Q_DISABLE_COPY(ImageCache)
+
+    static QString keyFor   (const QString& path, const QSize& size, qreal devicePixelRatio);
+    static int     costOf   (const QImage& image);
+    static int     costOf   (const QPixmap& pixmap);
+
+    QCache<QString, QPixmap> m_pixmaps;
+    QCache<QString, QImage>  m_sources;
+};
+
+#endif // IMAGECACHE_H
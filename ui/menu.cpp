@@ -5,6 +5,7 @@
 #include <QDebug>
 
 #include "ui/uielementfactory.h"
+#include "ui/textcache.h"
 
 Menu::Menu()
 {
@@ -29,20 +30,16 @@ void Menu::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWid
     // Drawing instruments
     painter->setRenderHint(QPainter::Antialiasing, true);
 
-    QPen border1Pen = QPen(QColor("#000"), 2);
-    QPen border2Pen = QPen(QColor("#eee"), 1);
-    QPen   textPen = QPen(Qt::white);
-    QColor backgroundColor = QColor("#111");
-    backgroundColor.setAlpha(233);
+    const PaintResources& resources = PaintResources::instance();
 
     // Draw shapes
-    painter->setPen(border1Pen);
+    painter->setPen(resources.pen(PaintResources::Pen::MENU_OUTER));
         painter->drawRect(boundingRect());
-    painter->setPen(border2Pen);
+    painter->setPen(resources.pen(PaintResources::Pen::MENU_INNER));
         painter->drawRect(boundingRect().adjusted(4, 4, -4, -4));
-        painter->fillRect(boundingRect().adjusted(4, 4, -4, -4), backgroundColor);
+        painter->fillRect(boundingRect().adjusted(4, 4, -4, -4), resources.brush(PaintResources::Brush::MENU_BACKGROUND));
 
-    painter->setPen(textPen);
+    painter->setPen(resources.pen(PaintResources::Pen::TEXT));
     for (int i = 0; i < m_buttons->count(); ++i)
     {
         UIElement* button = m_buttons->at(i);        
@@ -50,13 +47,13 @@ void Menu::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWid
         {
             if (!button->shape().isEmpty())
             {
-                painter->setPen(QPen(button->color(UIElement::Element::BORDER), button->borderWidth()));
+                painter->setPen(button->borderPen());
                     painter->drawPath(button->shape());
                     painter->fillPath(button->shape(), button->color(UIElement::Element::FILL));
 
-                painter->setPen(button->color(UIElement::Element::TEXT));
+                painter->setPen(button->textPen());
                 painter->setFont(button->font());
-                    painter->drawText(button->shape().boundingRect(), button->text(), QTextOption(Qt::AlignCenter));
+                    TextCache::instance().draw(painter, button->shape().boundingRect(), button->text(), resources.text(PaintResources::Text::CENTER));
             }
         }
     }
@@ -136,7 +133,7 @@ void Menu::defaultButtons()
         UIElement* button = m_buttons->at(i);
 
         button->setColor(UIElement::Element::FILL,   QColor("#111"));
-        button->setFont(QFont("Comic Sans", 10));
+        button->setFont(PaintResources::Font::BASIC);
         button->setText(button->defaultText());
     }
 }
@@ -0,0 +1,121 @@
+#include "paintresources.h"
+
+#include <QColor>
+
+#include "ui/textcache.h"
+
+PaintResources::PaintResources()
+{
+    build();
+}
+
+PaintResources &PaintResources::instance()
+{
+    static PaintResources resources;
+    return resources;
+}
+
+const QFont &PaintResources::font(PaintResources::Font font) const
+{
+    return m_fonts.at(static_cast<int>(font));
+}
+
+const QPen &PaintResources::pen(PaintResources::Pen pen) const
+{
+    return m_pens.at(static_cast<int>(pen));
+}
+
+const QBrush &PaintResources::brush(PaintResources::Brush brush) const
+{
+    return m_brushes.at(static_cast<int>(brush));
+}
+
+const QTextOption &PaintResources::text(PaintResources::Text text) const
+{
+    return m_texts.at(static_cast<int>(text));
+}
+
+const QBrush &PaintResources::actionBrush(GameTypes::ActionType actionType) const
+{
+    return m_actionBrushes.at(static_cast<int>(actionType));
+}
+
+const PaintResources::Theme &PaintResources::theme() const
+{
+    return m_theme;
+}
+
+void PaintResources::setTheme(const PaintResources::Theme &theme)
+{
+    m_theme = theme;
+    build();
+    ++m_revision;
+
+    // Labels are keyed by fonts, so the ones of the old theme would never be used again.
+    TextCache::instance().clear();
+}
+
+int PaintResources::revision() const
+{
+    return m_revision;
+}
+
+void PaintResources::build()
+{
+    m_fonts.resize(FONTS_COUNT);
+    m_fonts[static_cast<int>(Font::BASIC)]      = makeFont(m_theme.family, 10);
+    m_fonts[static_cast<int>(Font::SMALL)]      = makeFont(m_theme.family, 7);
+    m_fonts[static_cast<int>(Font::CARD)]       = makeFont(m_theme.cardFamily, 11);
+    m_fonts[static_cast<int>(Font::MENU_HOVER)] = makeFont(m_theme.cardFamily, 13);
+    m_fonts[static_cast<int>(Font::STATUS)]     = makeFont(m_theme.family, 11);
+
+    m_pens.resize(PENS_COUNT);
+    m_pens[static_cast<int>(Pen::TEXT)]           = QPen(Qt::white);
+    m_pens[static_cast<int>(Pen::TEXT_BUYING)]    = QPen(Qt::green);
+    m_pens[static_cast<int>(Pen::TEXT_UPGRADE)]   = QPen(Qt::lightGray);
+    m_pens[static_cast<int>(Pen::DETAILS_BORDER)] = QPen(QBrush(Qt::darkGray), 3.0f);
+    m_pens[static_cast<int>(Pen::HAND_PATH)]      = QPen(QBrush(Qt::white), 2);
+    m_pens[static_cast<int>(Pen::HAND_REGIONS)]   = QPen(QBrush(Qt::white), 1);
+    m_pens[static_cast<int>(Pen::MENU_OUTER)]     = QPen(QColor("#000"), 2);
+    m_pens[static_cast<int>(Pen::MENU_INNER)]     = QPen(QColor("#eee"), 1);
+    m_pens[static_cast<int>(Pen::DECK_OUTER)]     = QPen(QBrush(Qt::black), 1.0f);
+    m_pens[static_cast<int>(Pen::DECK_INNER)]     = QPen(QBrush(Qt::darkGray), 0.5f);
+    m_pens[static_cast<int>(Pen::DECK_TEXT)]      = QPen(Qt::lightGray, 1.0f);
+    m_pens[static_cast<int>(Pen::NODE_BORDER)]    = QPen(QBrush(Qt::white), 2.f);
+    m_pens[static_cast<int>(Pen::GRID_INNER)]     = QPen(QBrush(Qt::gray), 1, Qt::DashLine);
+    m_pens[static_cast<int>(Pen::GRID_BORDER)]    = QPen(QBrush(Qt::darkGray), 2, Qt::SolidLine);
+
+    QColor menuBackground ("#111");
+    menuBackground.setAlpha(233);
+    QColor detailsBackground ("#333");
+    detailsBackground.setAlpha(200);
+
+    m_brushes.resize(BRUSHES_COUNT);
+    m_brushes[static_cast<int>(Brush::HAND_FILL)]          = QBrush(QColor("#eee"));
+    m_brushes[static_cast<int>(Brush::HAND_REGIONS)]       = QBrush(QColor("#111"));
+    m_brushes[static_cast<int>(Brush::MENU_BACKGROUND)]    = QBrush(menuBackground);
+    m_brushes[static_cast<int>(Brush::DETAILS_BACKGROUND)] = QBrush(detailsBackground);
+    m_brushes[static_cast<int>(Brush::NODE_FILL)]          = QBrush(Qt::black);
+    m_brushes[static_cast<int>(Brush::NODE_COMPANY)]       = QBrush(QColor("#4682b4"));
+
+    using ActionType = GameTypes::ActionType;
+    m_actionBrushes.resize(GameTypes::ACTION_TYPES_COUNT);
+    m_actionBrushes[static_cast<int>(ActionType::START)]         = QBrush(QColor("#2e8b57"));
+    m_actionBrushes[static_cast<int>(ActionType::PORTAL)]        = QBrush(QColor("#8a2be2"));
+    m_actionBrushes[static_cast<int>(ActionType::PRISON)]        = QBrush(QColor("#8b0000"));
+    m_actionBrushes[static_cast<int>(ActionType::EXCHANGE)]      = QBrush(QColor("#daa520"));
+    m_actionBrushes[static_cast<int>(ActionType::MOVE_FORWARD)]  = QBrush(QColor("#20b2aa"));
+    m_actionBrushes[static_cast<int>(ActionType::MOVE_BACKWARD)] = QBrush(QColor("#ff8c00"));
+    m_actionBrushes[static_cast<int>(ActionType::CARD_POSITIVE)] = QBrush(QColor("#87cefa"));
+    m_actionBrushes[static_cast<int>(ActionType::CARD_NEGATIVE)] = QBrush(QColor("#c71585"));
+
+    m_texts.resize(TEXTS_COUNT);
+    m_texts[static_cast<int>(Text::CENTER)]     = QTextOption(Qt::AlignCenter);
+    m_texts[static_cast<int>(Text::CENTER_TOP)] = QTextOption(Qt::AlignCenter | Qt::AlignTop);
+    m_texts[static_cast<int>(Text::TOP_LEFT)]   = QTextOption(Qt::AlignTop | Qt::AlignLeft);
+}
+
+QFont PaintResources::makeFont(const QString &family, int pointSize) const
+{
+    return QFont(family, qMax(1, qRound(pointSize * m_theme.fontScale)));
+}
@@ -0,0 +1,77 @@
+#ifndef PAINTRESOURCES_H
+#define PAINTRESOURCES_H
+
+#include <QFont>
+#include <QPen>
+#include <QBrush>
+#include <QTextOption>
+#include <QString>
+#include <QVector>
+
+#include "core/gametypes.h"
+
+// PaintResources is the process-wide registry of the drawing instruments shared by all items of the table.
+// Paint methods used to create fonts (each one is a lookup in the font database), pens, brushes and text options
+// on every call; now they are made once from the theme and paint methods take const references to them.
+// - Font, Pen, Brush and Text name the role of the instrument, not its look, so the theme may change the look;
+// - setTheme rebuilds everything at once and increases the revision,
+//   items, that cache their rendering (decks, board layer), compare revisions to know when to render again;
+// - colors of players and of separate UI elements are not the part of the theme, those items keep their own instruments.
+
+class PaintResources
+{
+public:
+    enum class Font  {BASIC, SMALL, CARD, MENU_HOVER, STATUS};
+    enum class Pen   {TEXT, TEXT_BUYING, TEXT_UPGRADE, DETAILS_BORDER,
+                      HAND_PATH, HAND_REGIONS, MENU_OUTER, MENU_INNER,
+                      DECK_OUTER, DECK_INNER, DECK_TEXT, NODE_BORDER, GRID_INNER, GRID_BORDER};
+    enum class Brush {HAND_FILL, HAND_REGIONS, MENU_BACKGROUND, DETAILS_BACKGROUND, NODE_FILL, NODE_COMPANY};
+    enum class Text  {CENTER, CENTER_TOP, TOP_LEFT};
+
+    static constexpr int FONTS_COUNT   = 5;
+    static constexpr int PENS_COUNT    = 14;
+    static constexpr int BRUSHES_COUNT = 6;
+    static constexpr int TEXTS_COUNT   = 3;
+
+    // Theme:
+    // - family is used for all the texts of the table, cardFamily for the names of cards and hovered menu buttons;
+    // - fontScale multiplies all point sizes.
+    struct Theme
+    {
+        QString family     = "Comic Sans";
+        QString cardFamily = "Truetypewriter PolyglOTT";
+        qreal   fontScale  = 1.0;
+    };
+
+    static PaintResources& instance();
+
+    const QFont&       font  (Font font) const;
+    const QPen&        pen   (Pen pen) const;
+    const QBrush&      brush (Brush brush) const;
+    const QTextOption& text  (Text text) const;
+
+    // * actionBrush returns the flat colour of nodes with action tokens of specific type (far zoomed out board).
+    const QBrush& actionBrush (GameTypes::ActionType actionType) const;
+
+    const Theme& theme () const;
+    void setTheme (const Theme& theme);
+    int  revision () const;
+
+private:
+    PaintResources();
+    Q_DISABLE_COPY(PaintResources)
+
+    void  build ();
+    QFont makeFont (const QString& family, int pointSize) const;
+
+    Theme m_theme;
+    int   m_revision = 0;
+
+    QVector<QFont>       m_fonts;
+    QVector<QPen>        m_pens;
+    QVector<QBrush>      m_brushes;
+    QVector<QBrush>      m_actionBrushes;
+    QVector<QTextOption> m_texts;
+};
+
+#endif // PAINTRESOURCES_H
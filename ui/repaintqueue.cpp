@@ -0,0 +1,114 @@
+#include "repaintqueue.h"
+
+#include <QGraphicsScene>
+#include <QGraphicsItem>
+
+RepaintQueue::RepaintQueue(QGraphicsScene *scene, QObject *parent)
+    : QObject (parent)
+    , m_scene (scene)
+{
+    m_frameTimer.setSingleShot(true);
+    connect(&m_frameTimer, &QTimer::timeout, this, &RepaintQueue::flush);
+}
+
+void RepaintQueue::setUIUpdater(const std::function<void ()> &updater)
+{
+    m_uiUpdater = updater;
+}
+
+void RepaintQueue::invalidate(const QRectF &region)
+{
+    if (region.isEmpty())
+        return;
+
+    // The same regions (hands, nodes) are marked many times, so the list stays short.
+    for (int i = 0; i < m_regions.count(); ++i)
+    {
+        if (m_regions.at(i).contains(region))
+            return;
+
+        if (region.contains(m_regions.at(i)))
+            m_regions.remove(i--);
+    }
+
+    m_regions.append(region);
+    schedule();
+}
+
+void RepaintQueue::invalidate(QGraphicsItem *item)
+{
+    if (item == nullptr)
+        return;
+
+    m_items.insert(item);
+    schedule();
+}
+
+void RepaintQueue::invalidateUI()
+{
+    m_uiDirty = true;
+    schedule();
+}
+
+void RepaintQueue::forget(QGraphicsItem *item)
+{
+    m_items.remove(item);
+}
+
+void RepaintQueue::clear()
+{
+    m_frameTimer.stop();
+    m_regions.clear();
+    m_items.clear();
+    m_uiDirty = false;
+}
+
+void RepaintQueue::suspend()
+{
+    ++m_suspended;
+    m_frameTimer.stop();
+}
+
+void RepaintQueue::resume()
+{
+    if (m_suspended == 0 || --m_suspended > 0)
+        return;
+
+    flush();
+}
+
+bool RepaintQueue::isSuspended() const
+{
+    return m_suspended > 0;
+}
+
+void RepaintQueue::flush()
+{
+    if (m_suspended > 0)
+        return;
+
+    m_frameTimer.stop();
+
+    // UI updater may mark some regions too, so it goes first.
+    if (m_uiDirty)
+    {
+        m_uiDirty = false;
+        if (m_uiUpdater)
+            m_uiUpdater();
+    }
+
+    for (QGraphicsItem* item : qAsConst(m_items))
+        item->update();
+    m_items.clear();
+
+    if (m_scene)
+        for (const QRectF& region : qAsConst(m_regions))
+            m_scene->update(region);
+    m_regions.clear();
+}
+
+void RepaintQueue::schedule()
+{
+    if (m_suspended == 0 && !m_frameTimer.isActive())
+        m_frameTimer.start(FRAME_INTERVAL);
+}
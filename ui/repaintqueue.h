@@ -0,0 +1,62 @@
+#ifndef REPAINTQUEUE_H
+#define REPAINTQUEUE_H
+
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+#include <QSet>
+#include <QRectF>
+
+#include <functional>
+
+class QGraphicsScene;
+class QGraphicsItem;
+
+// RepaintQueue collects the parts of the scene, that should be repainted, and repaints each of them once per frame.
+// Several events of one card (gold of each opponent, for example) mark the same regions again and again,
+// but the work done on flush depends only on the count of different regions.
+// - invalidate marks the scene region or the whole item, region, that lies inside of already marked one, is dropped;
+// - invalidateUI marks the labels and status item, they are updated by the function set with setUIUpdater;
+// - flush repaints everything marked at once, it is called by the frame timer FRAME_INTERVAL ms after the first mark;
+// - suspend and resume stop flushing for a while (fast-forward), resume flushes everything marked meanwhile;
+// - forget drops the mark of one item, it is called by each path, that deletes items, which may be marked
+//   (units, hands, nodes, their tokens and cards), so flush never updates the deleted item;
+// - clear forgets all the marks.
+
+class RepaintQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr int FRAME_INTERVAL = 16;
+
+    explicit RepaintQueue(QGraphicsScene* scene, QObject* parent = nullptr);
+
+    void setUIUpdater (const std::function<void()>& updater);
+
+    void invalidate   (const QRectF& region);
+    void invalidate   (QGraphicsItem* item);
+    void invalidateUI ();
+    void forget (QGraphicsItem* item);
+    void clear ();
+
+    void suspend ();
+    void resume  ();
+    bool isSuspended () const;
+
+public slots:
+    void flush ();
+
+private:
+    void schedule ();
+
+    QGraphicsScene*       m_scene = nullptr;
+    std::function<void()> m_uiUpdater;
+    QTimer                m_frameTimer;
+    QVector<QRectF>       m_regions;
+    QSet<QGraphicsItem*>  m_items;
+    bool                  m_uiDirty = false;
+    int                   m_suspended = 0;
+};
+
+#endif // REPAINTQUEUE_H
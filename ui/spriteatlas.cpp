@@ -0,0 +1,119 @@
+#include "spriteatlas.h"
+
+#include <QPainter>
+#include <QtMath>
+#include <QDebug>
+
+SpriteAtlas::SpriteAtlas()
+{
+    clear();
+}
+
+SpriteAtlas &SpriteAtlas::instance()
+{
+    static SpriteAtlas atlas;
+    return atlas;
+}
+
+SpriteAtlas::Sprite SpriteAtlas::find(const QString &key) const
+{
+    Sprite sprite;
+    auto it = m_sprites.constFind(key);
+    if (it != m_sprites.constEnd())
+    {
+        sprite.source = it.value();
+        sprite.generation = m_generation;
+    }
+
+    return sprite;
+}
+
+SpriteAtlas::Sprite SpriteAtlas::add(const QString &key, const QSizeF &size, qreal scale, const std::function<void(QPainter*)>& render)
+{
+    Sprite sprite = find(key);
+    if (isValid(sprite))
+        return sprite;
+
+    QSize deviceSize (qCeil(size.width() * scale), qCeil(size.height() * scale));
+    if (deviceSize.isEmpty() || deviceSize.width() > ATLAS_SIDE || deviceSize.height() > ATLAS_SIDE)
+        return sprite;
+
+    QPoint place;
+    if (!allocate(deviceSize, place))
+    {
+        // Atlas is full: sprites of units, that are not shown anymore, are dropped together with the others.
+        qDebug() << "SpriteAtlas:: atlas is full, it is cleared.";
+        clear();
+        allocate(deviceSize, place);
+    }
+
+    // The texture is created by the first sprite, after the atlas has been cleared.
+    if (m_atlas.isNull())
+    {
+        m_atlas = QPixmap(ATLAS_SIDE, ATLAS_SIDE);
+        m_atlas.fill(Qt::transparent);
+    }
+
+    QRect source (place, deviceSize);
+    {
+        QPainter painter (&m_atlas);
+        painter.setCompositionMode(QPainter::CompositionMode_Source);
+        painter.fillRect(source, Qt::transparent);
+        painter.setCompositionMode(QPainter::CompositionMode_SourceOver);
+        painter.setClipRect(source);
+        painter.translate(place);
+        painter.scale(scale, scale);
+        render(&painter);
+    }
+
+    m_sprites.insert(key, source);
+
+    sprite.source = source;
+    sprite.generation = m_generation;
+    return sprite;
+}
+
+bool SpriteAtlas::isValid(const SpriteAtlas::Sprite &sprite) const
+{
+    return sprite.generation == m_generation && !sprite.source.isEmpty();
+}
+
+void SpriteAtlas::draw(QPainter *painter, const QRectF &target, const SpriteAtlas::Sprite &sprite) const
+{
+    painter->drawPixmap(target, m_atlas, sprite.source);
+}
+
+void SpriteAtlas::clear()
+{
+    m_atlas = QPixmap();
+    m_sprites.clear();
+
+    m_shelfTop = 0;
+    m_shelfHeight = 0;
+    m_shelfLeft = 0;
+    ++m_generation;
+}
+
+int SpriteAtlas::generation() const
+{
+    return m_generation;
+}
+
+bool SpriteAtlas::allocate(const QSize &size, QPoint &place)
+{
+    // Sprite doesn't fit the rest of the shelf, so the new shelf is started below.
+    if (m_shelfLeft + size.width() > ATLAS_SIDE)
+    {
+        m_shelfTop += m_shelfHeight + SPACING;
+        m_shelfHeight = 0;
+        m_shelfLeft = 0;
+    }
+
+    if (m_shelfTop + size.height() > ATLAS_SIDE)
+        return false;
+
+    place = QPoint(m_shelfLeft, m_shelfTop);
+    m_shelfLeft += size.width() + SPACING;
+    m_shelfHeight = qMax(m_shelfHeight, size.height());
+    return true;
+}
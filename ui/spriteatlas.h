@@ -0,0 +1,68 @@
+#ifndef SPRITEATLAS_H
+#define SPRITEATLAS_H
+
+#include <QPixmap>
+#include <QHash>
+#include <QString>
+#include <QRectF>
+
+#include <functional>
+
+class QPainter;
+
+// SpriteAtlas is the process-wide texture of small pre-rendered pictures (units for now), that are drawn by a single blit.
+// Each picture is rendered once into its own place in the atlas, so paint doesn't build paths or fill shapes every frame.
+// - sprites are keyed by the string, that describes everything they depend on (shape, colour, size, scale);
+// - places are allocated row by row ("shelves"), SPACING px are left between sprites, so smooth scaling doesn't bleed;
+// - when the atlas is full, it is cleared and generation is increased, owners of sprites check it and add them again;
+// - pictures larger than the atlas are not added, the returned sprite is not valid and owners draw them directly;
+// - the texture is released by clear and created again by the next add, so the owner of the scene clears the atlas,
+//   before QApplication is gone (pixmap can't outlive it).
+// The atlas is used from the GUI thread only.
+
+class SpriteAtlas
+{
+public:
+    static constexpr int ATLAS_SIDE = 1024;
+    static constexpr int SPACING = 1;
+
+    // Sprite is the place of the picture in the atlas: source rect in device pixels and its generation.
+    struct Sprite
+    {
+        QRectF source;
+        int    generation = -1;
+    };
+
+    static SpriteAtlas& instance();
+
+    // * find returns the sprite with specific key (not valid, if there is none);
+    // * add renders the picture of size (in device independent pixels) at scale using render function,
+    //   that draws it at the origin, and returns its sprite (the existing one, if key is already there);
+    // * isValid returns true, if the sprite is still in the atlas;
+    // * draw blits the sprite into target rect;
+    // * clear drops all the sprites and releases the texture.
+    Sprite find   (const QString& key) const;
+    Sprite add    (const QString& key, const QSizeF& size, qreal scale, const std::function<void(QPainter*)>& render);
+    bool   isValid(const Sprite& sprite) const;
+    void   draw   (QPainter* painter, const QRectF& target, const Sprite& sprite) const;
+    void   clear  ();
+
+    int generation () const;
+
+private:
+    SpriteAtlas();
+    Q_DISABLE_COPY(SpriteAtlas)
+
+    bool allocate (const QSize& size, QPoint& place);
+
+    QPixmap m_atlas;
+    QHash<QString, QRect> m_sprites;
+    int m_generation = 0;
+
+    // Current shelf: its top, height and the first free column.
+    int m_shelfTop = 0;
+    int m_shelfHeight = 0;
+    int m_shelfLeft = 0;
+};
+
+#endif // SPRITEATLAS_H
@@ -0,0 +1,86 @@
+#include "textcache.h"
+
+#include <QPainter>
+#include <QFont>
+#include <QFontMetricsF>
+#include <QTextOption>
+#include <QTransform>
+
+TextCache::TextCache()
+{
+    m_labels.setMaxCost(CAPACITY);
+}
+
+TextCache &TextCache::instance()
+{
+    static TextCache cache;
+    return cache;
+}
+
+void TextCache::draw(QPainter *painter, const QRectF &box, const QString &text, const QTextOption &option)
+{
+    if (text.isEmpty())
+        return;
+
+    const Label* cached = label(text, painter->font(), box.width(), &option);
+
+    // QStaticText aligns lines horizontally inside its width, vertical alignment inside the box is made here.
+    qreal y = box.y();
+    Qt::Alignment alignment = option.alignment();
+    if (alignment & Qt::AlignVCenter)
+        y += (box.height() - cached->size.height()) / 2;
+    else if (alignment & Qt::AlignBottom)
+        y += box.height() - cached->size.height();
+
+    painter->drawStaticText(QPointF(box.x(), y), cached->text);
+}
+
+void TextCache::draw(QPainter *painter, const QPointF &baseline, const QString &text)
+{
+    if (text.isEmpty())
+        return;
+
+    const Label* cached = label(text, painter->font(), -1, nullptr);
+
+    // Static text is placed by its top left corner, so the baseline is moved up by the ascent of the font.
+    painter->drawStaticText(baseline - QPointF(0, cached->ascent), cached->text);
+}
+
+int TextCache::count() const
+{
+    return m_labels.count();
+}
+
+void TextCache::clear()
+{
+    m_labels.clear();
+}
+
+const TextCache::Label *TextCache::label(const QString &text, const QFont &font, qreal width, const QTextOption *option)
+{
+    QString key = QString("%1|%2|%3|%4|%5").arg(font.key()).arg(width)
+                                           .arg(option ? int(option->alignment()) : -1)
+                                           .arg(option ? int(option->wrapMode())  : -1)
+                                           .arg(text);
+
+    Label* cached = m_labels.object(key);
+    if (cached)
+        return cached;
+
+    cached = new Label();
+    cached->text.setText(text);
+    cached->text.setTextFormat(Qt::PlainText);
+    if (option)
+    {
+        cached->text.setTextOption(*option);
+        cached->text.setTextWidth(width);
+    }
+
+    // Shaping and layout are made here once, drawing only moves the prepared glyphs.
+    cached->text.prepare(QTransform(), font);
+    cached->size = cached->text.size();
+    cached->ascent = QFontMetricsF(font).ascent();
+
+    m_labels.insert(key, cached);
+    return cached;
+}
@@ -0,0 +1,53 @@
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include <QCache>
+#include <QStaticText>
+#include <QString>
+#include <QRectF>
+
+class QPainter;
+class QFont;
+class QTextOption;
+
+// TextCache keeps the labels of the table (coordinates of nodes, gold and names in hands, names of cards,
+// texts of details, menu and status) shaped and laid out, so unchanged labels are just drawn on repaint.
+// - label is the QStaticText keyed by its string, font, box width and text option, the position of the box is not the part of the key,
+//   so the same label in another place (or in the moving item) is the same entry;
+// - draw with the box works like QPainter::drawText with QTextOption, draw with the point places the baseline of the label there;
+// - the font of the painter is used, so it should be set before drawing;
+// - changed text (gold, for example) is the new entry, the other labels of the item stay untouched,
+//   old entries are dropped by LRU policy, when count of labels reaches CAPACITY.
+// The cache is used from the GUI thread only.
+
+class TextCache
+{
+public:
+    static constexpr int CAPACITY = 1024;
+
+    static TextCache& instance();
+
+    void draw (QPainter* painter, const QRectF& box, const QString& text, const QTextOption& option);
+    void draw (QPainter* painter, const QPointF& baseline, const QString& text);
+
+    // * count returns count of labels cached, clear drops all of them (after theme changes, for example).
+    int  count () const;
+    void clear ();
+
+private:
+    TextCache();
+    Q_DISABLE_COPY(TextCache)
+
+    struct Label
+    {
+        QStaticText text;
+        QSizeF      size;
+        qreal       ascent;
+    };
+
+    const Label* label (const QString& text, const QFont& font, qreal width, const QTextOption* option);
+
+    QCache<QString, Label> m_labels;
+};
+
+#endif // TEXTCACHE_H
@@ -3,6 +3,8 @@
 #include <QPainter>
 #include <QDebug>
 
+#include "ui/textcache.h"
+
 UIElement::UIElement(const QString& message, QGraphicsRectItem* parent)
     : QGraphicsRectItem (parent)
 {
@@ -79,7 +81,10 @@ void UIElement::setShape(const Shape& shape)
 void UIElement::setBorderWidth(int width)
 {
     if (width >= 0 && width <= 5)
+    {
         m_borderWidth = width;
+        m_borderPen = QPen(QBrush(m_borderColor), m_borderWidth);
+    }
     else
         qDebug() << "Width should be in range[0;5].";
 }
@@ -90,6 +95,7 @@ void UIElement::setColor(UIElement::Element instrument, const QColor &color)
     {
         case UIElement::Element::BORDER:
         m_borderColor = color;
+        m_borderPen = QPen(QBrush(m_borderColor), m_borderWidth);
         break;
 
         case UIElement::Element::FILL:
@@ -98,12 +104,20 @@ void UIElement::setColor(UIElement::Element instrument, const QColor &color)
 
         case UIElement::Element::TEXT:
         m_textColor = color;
+        m_textPen = QPen(m_textColor);
     }
 }
 
 void UIElement::setFont(const QFont &font)
 {
     m_font = font;
+    m_themedFont = false;
+}
+
+void UIElement::setFont(PaintResources::Font font)
+{
+    m_fontRole = font;
+    m_themedFont = true;
 }
 
 void UIElement::setText(const QString &text)
@@ -167,7 +181,17 @@ const QString &UIElement::text() const
 
 const QFont &UIElement::font() const
 {
-    return m_font;
+    return m_themedFont ? PaintResources::instance().font(m_fontRole) : m_font;
+}
+
+const QPen &UIElement::borderPen() const
+{
+    return m_borderPen;
+}
+
+const QPen &UIElement::textPen() const
+{
+    return m_textPen;
 }
 
 const int &UIElement::borderWidth() const
@@ -198,8 +222,6 @@ void UIElement::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
 
     // Prepare drawing instruments.
     painter->setRenderHint(QPainter::Antialiasing);
-    QPen borderPen(QBrush(m_borderColor), m_borderWidth);
-    QPen   textPen(m_textColor);
 
     // Draw UIElement shape and put some text inside.
     // Since the path is generated at origin position, we need to move the painter to where it should be drawn.
@@ -207,12 +229,12 @@ void UIElement::paint(QPainter *painter, const QStyleOptionGraphicsItem *option,
 
     if (!m_path.isEmpty())
     {
-        painter->setPen(borderPen);
+        painter->setPen(m_borderPen);
             painter->drawPath(m_path);
             painter->fillPath(m_path, m_fillColor);
 
-        painter->setPen(textPen);
-        painter->setFont(m_font);
-            painter->drawText(m_path.boundingRect(), m_defaultText, QTextOption(Qt::AlignCenter));
+        painter->setPen(m_textPen);
+        painter->setFont(font());
+            TextCache::instance().draw(painter, m_path.boundingRect(), m_defaultText, PaintResources::instance().text(PaintResources::Text::CENTER));
     }    
 }
@@ -6,6 +6,8 @@
 #include <QFont>
 #include <QPen>
 
+#include "ui/paintresources.h"
+
 class UIElement : public QGraphicsRectItem
 {
 public:
@@ -29,6 +31,7 @@ public:
     void setColor(Element instrument, const QColor& color);
     void setText(const QString& text);
     void setFont (const QFont& font);
+    void setFont (PaintResources::Font font);
     void setBorderWidth(int width);
 
     const Role& role() const;
@@ -40,6 +43,8 @@ public:
     const QString& text() const;
     const QFont& font() const;
     const int& borderWidth() const;
+    const QPen& borderPen() const;
+    const QPen& textPen() const;
 
 
 
@@ -53,10 +58,15 @@ private:
     QRectF m_bR;
     QPoint m_position;
     QSize  m_size;
-    int    m_borderWidth;
+    int    m_borderWidth = 0;
     QColor m_borderColor, m_fillColor, m_textColor;
 
-    QFont   m_font;    
+    // Pens are rebuilt, when colors or border width change, not on every paint.
+    // Font is either the own one or the role in paint resources, so it follows the theme.
+    QPen    m_borderPen, m_textPen;
+    QFont   m_font;
+    PaintResources::Font m_fontRole = PaintResources::Font::BASIC;
+    bool    m_themedFont = false;
     QString m_defaultText, m_currentText;
 };
 
@@ -15,7 +15,7 @@ UIElement *UIElementFactory::create(UIElement::Role role, const QString &text, c
     button->setColor(UIElement::Element::BORDER, QColor("#fff"));
     button->setColor(UIElement::Element::FILL,   QColor("#111"));
     button->setColor(UIElement::Element::TEXT,   QColor("#fff"));
-    button->setFont(QFont("Comic Sans", 10));
+    button->setFont(PaintResources::Font::BASIC);
     button->setParentItem(parent);
 
     return button;